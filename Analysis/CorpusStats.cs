@@ -0,0 +1,212 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using DialScript.Models;
+using DialScript.Parsing;
+
+namespace DialScript.Analysis;
+
+public class TextCounts
+{
+    public long Lines { get; set; }
+    
+    public long Words { get; set; }
+    
+    public long Characters { get; set; }
+    
+    public void Add(long words, long characters)
+    {
+        Lines++;
+        Words += words;
+        Characters += characters;
+    }
+    
+    public void Merge(TextCounts other)
+    {
+        Lines += other.Lines;
+        Words += other.Words;
+        Characters += other.Characters;
+    }
+}
+
+public class CorpusStats
+{
+    // Histogram of dialog text length: [0-19], [20-39], ..., [200+]
+    public const int HistogramBucketSize = 20;
+    public const int HistogramBuckets = 11;
+    
+    public int Files { get; set; }
+    
+    public long TotalLines { get; set; }
+    
+    public TextCounts Dialog { get; } = new();
+    
+    public Dictionary<string, TextCounts> BySpeaker { get; } = new(StringComparer.Ordinal);
+    
+    public Dictionary<string, TextCounts> ByScene { get; } = new(StringComparer.Ordinal);
+    
+    public Dictionary<string, TextCounts> ByLocation { get; } = new(StringComparer.Ordinal);
+    
+    public Dictionary<string, TextCounts> ByLevel { get; } = new(StringComparer.Ordinal);
+    
+    public Dictionary<string, long> Emotions { get; } = new(StringComparer.OrdinalIgnoreCase);
+    
+    public long[] LineLengthHistogram { get; } = new long[HistogramBuckets];
+    
+    // Adds one file to this (thread-local) aggregate
+    public void AddFile(string filePath, string sceneKeyPrefix)
+    {
+        var lines = File.ReadAllLines(filePath);
+        Files++;
+        TotalLines += lines.Length;
+        
+        string? scene = null;
+        string? location = null;
+        string? level = null;
+        
+        for (var i = 0; i < lines.Length; i++)
+        {
+            var parsed = LineParser.Parse(lines[i], i + 1);
+            switch (parsed.Type)
+            {
+                case LineType.Scene:
+                    scene = $"{sceneKeyPrefix} [Scene.{parsed.Number}]";
+                    location = null;
+                    level = null;
+                    break;
+                    
+                case LineType.Location:
+                    location = parsed.Value;
+                    break;
+                    
+                case LineType.Level:
+                    level = parsed.Value;
+                    break;
+                    
+                case LineType.Dialog:
+                    AddDialogLine(parsed, scene, location, level);
+                    break;
+            }
+        }
+    }
+    
+    public void Merge(CorpusStats other)
+    {
+        Files += other.Files;
+        TotalLines += other.TotalLines;
+        Dialog.Merge(other.Dialog);
+        
+        MergeCounts(BySpeaker, other.BySpeaker);
+        MergeCounts(ByScene, other.ByScene);
+        MergeCounts(ByLocation, other.ByLocation);
+        MergeCounts(ByLevel, other.ByLevel);
+        
+        foreach (var (emotion, count) in other.Emotions)
+        {
+            Emotions[emotion] = Emotions.GetValueOrDefault(emotion) + count;
+        }
+        
+        for (var i = 0; i < HistogramBuckets; i++)
+        {
+            LineLengthHistogram[i] += other.LineLengthHistogram[i];
+        }
+    }
+    
+    private void AddDialogLine(ParsedLine parsed, string? scene, string? location, string? level)
+    {
+        var text = parsed.TextSpan;
+        var words = CountWords(text);
+        var characters = text.Length;
+        
+        Dialog.Add(words, characters);
+        AddCounts(BySpeaker, parsed.CharacterName ?? "", words, characters);
+        AddCounts(ByScene, scene ?? "(no scene)", words, characters);
+        AddCounts(ByLocation, location ?? "(no location)", words, characters);
+        AddCounts(ByLevel, level ?? "(no level)", words, characters);
+        
+        var bucket = Math.Min(characters / HistogramBucketSize, HistogramBuckets - 1);
+        LineLengthHistogram[bucket]++;
+        
+        if (parsed.HasMetadata)
+        {
+            foreach (var entry in new MetadataParser(parsed.MetadataSpan))
+            {
+                if (entry.Key.Equals("Emotion", StringComparison.OrdinalIgnoreCase))
+                {
+                    var emotion = entry.Value.ToString();
+                    Emotions[emotion] = Emotions.GetValueOrDefault(emotion) + 1;
+                }
+            }
+        }
+    }
+    
+    private static void AddCounts(Dictionary<string, TextCounts> counts, string key, long words, long characters)
+    {
+        if (!counts.TryGetValue(key, out var entry))
+        {
+            entry = new TextCounts();
+            counts[key] = entry;
+        }
+        entry.Add(words, characters);
+    }
+    
+    private static void MergeCounts(Dictionary<string, TextCounts> target, Dictionary<string, TextCounts> source)
+    {
+        foreach (var (key, counts) in source)
+        {
+            if (!target.TryGetValue(key, out var entry))
+            {
+                entry = new TextCounts();
+                target[key] = entry;
+            }
+            entry.Merge(counts);
+        }
+    }
+    
+    private static int CountWords(ReadOnlySpan<char> text)
+    {
+        var words = 0;
+        var inWord = false;
+        foreach (var c in text)
+        {
+            if (char.IsWhiteSpace(c))
+            {
+                inWord = false;
+            }
+            else if (!inWord)
+            {
+                inWord = true;
+                words++;
+            }
+        }
+        return words;
+    }
+}
+
+public static class StatsCollector
+{
+    // Collects stats for all files in one parallel pass. Each worker fills its own
+    // CorpusStats and the partial aggregates are merged once at the end
+    public static CorpusStats Collect(IReadOnlyList<string> files, string rootPath)
+    {
+        var total = new CorpusStats();
+        
+        Parallel.ForEach(files,
+            () => new CorpusStats(),
+            (file, _, local) =>
+            {
+                local.AddFile(file, Path.GetRelativePath(rootPath, file));
+                return local;
+            },
+            local =>
+            {
+                lock (total)
+                {
+                    total.Merge(local);
+                }
+            });
+        
+        return total;
+    }
+}
@@ -0,0 +1,268 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Threading.Channels;
+using DialScript.Export;
+using DialScript.Formatting;
+using DialScript.Models;
+using DialScript.Output;
+using DialScript.Parsing;
+
+namespace DialScript.Compiler;
+
+public enum DiagnosticOrder
+{
+    Sorted,                      // Buffer diagnostics per worker, merge by path at the end
+    Streaming                    // Release each file once all earlier files are done
+}
+
+public class PipelineSettings
+{
+    // I/O bound, so more readers than cores is fine on slow drives
+    public int Readers { get; set; } = 4;
+    
+    public int Parsers { get; set; } = Environment.ProcessorCount;
+    
+    public int Validators { get; set; } = Math.Max(1, Environment.ProcessorCount / 2);
+    
+    // Max files waiting between two stages
+    public int Capacity { get; set; } = 64;
+    
+    public DiagnosticOrder Order { get; set; } = DiagnosticOrder.Sorted;
+}
+
+public class PipelineSummary
+{
+    public int Files { get; set; }
+    
+    public long TotalLines { get; set; }
+    
+    public int Errors { get; set; }
+}
+
+// Directory compile mode: read → parse → validate → emit, each stage is a group of workers
+// connected by bounded channels, so reading of the next files overlaps with parsing.
+// Files are ordered by path and diagnostics always come out in that order (then by line),
+// no matter which worker finished first
+public class CompilePipeline
+{
+    // Source is null if the file couldn't be read, then Error says why
+    private record SourceFile(int Index, string Path, SourceText? Source, Exception? Error = null);
+    
+    private record ParsedFile(int Index, string Path, SourceText? Source, ParsedLine[]? ParsedLines, Exception? Error);
+    
+    private record CompiledFile(int Index, CompileResult Result);
+    
+    private readonly CompilerSettings _settings;
+    private readonly PipelineSettings _pipelineSettings;
+    
+    public CompilePipeline(CompilerSettings? settings = null, PipelineSettings? pipelineSettings = null)
+    {
+        _settings = settings ?? new CompilerSettings();
+        _pipelineSettings = pipelineSettings ?? new PipelineSettings();
+    }
+
+    public async Task<PipelineSummary> RunAsync(IReadOnlyList<string> files, CancellationToken cancellationToken = default)
+    {
+        var orderedFiles = files.Distinct().Order(StringComparer.Ordinal).ToArray();
+        
+        var paths = CreateChannel<(int Index, string Path)>();
+        var sources = CreateChannel<SourceFile>();
+        var parsed = CreateChannel<ParsedFile>();
+        var summary = new PipelineSummary();
+        
+        var producer = Task.Run(async () =>
+        {
+            for (var i = 0; i < orderedFiles.Length; i++)
+            {
+                await paths.Writer.WriteAsync((i, orderedFiles[i]), cancellationToken);
+            }
+            paths.Writer.Complete();
+        }, cancellationToken);
+        
+        var readers = RunStage(_pipelineSettings.Readers, paths.Reader, sources.Writer, () => ReadAsync, cancellationToken);
+        var parsers = RunStage(_pipelineSettings.Parsers, sources.Reader, parsed.Writer, () => ParseAsync, cancellationToken);
+        
+        if (_pipelineSettings.Order == DiagnosticOrder.Streaming)
+        {
+            var results = CreateChannel<CompiledFile>();
+            var validators = RunStage(_pipelineSettings.Validators, parsed.Reader, results.Writer, CreateValidator, cancellationToken);
+            var writer = WriteInOrderAsync(results.Reader, summary, cancellationToken);
+            await Task.WhenAll(producer, readers, parsers, validators, writer);
+        }
+        else
+        {
+            var buffers = await RunBufferedValidators(parsed.Reader, cancellationToken);
+            await Task.WhenAll(producer, readers, parsers);
+            foreach (var file in Merge(buffers))
+            {
+                Emit(file.Result, summary);
+            }
+        }
+        
+        return summary;
+    }
+    
+    private Channel<T> CreateChannel<T>()
+    {
+        return Channel.CreateBounded<T>(new BoundedChannelOptions(_pipelineSettings.Capacity)
+        {
+            FullMode = BoundedChannelFullMode.Wait
+        });
+    }
+    
+    // Runs `workers` copies of a stage and completes the output channel when all of them are done
+    private static async Task RunStage<TIn, TOut>(int workers, ChannelReader<TIn> input, ChannelWriter<TOut> output,
+        Func<Func<TIn, ValueTask<TOut>>> createWorker, CancellationToken cancellationToken)
+    {
+        var tasks = new Task[Math.Max(1, workers)];
+        for (var i = 0; i < tasks.Length; i++)
+        {
+            tasks[i] = Task.Run(async () =>
+            {
+                var process = createWorker();
+                await foreach (var item in input.ReadAllAsync(cancellationToken))
+                {
+                    await output.WriteAsync(await process(item), cancellationToken);
+                }
+            }, cancellationToken);
+        }
+        
+        try
+        {
+            await Task.WhenAll(tasks);
+            output.Complete();
+        }
+        catch (Exception e)
+        {
+            output.Complete(e);
+            throw;
+        }
+    }
+    
+    private async ValueTask<SourceFile> ReadAsync((int Index, string Path) file)
+    {
+        try
+        {
+            return new SourceFile(file.Index, file.Path, await SourceText.LoadAsync(file.Path));
+        }
+        catch (Exception e) when (e is IOException or UnauthorizedAccessException)
+        {
+            return new SourceFile(file.Index, file.Path, null, e);
+        }
+    }
+    
+    private static ValueTask<ParsedFile> ParseAsync(SourceFile source)
+    {
+        var parsedLines = source.Source != null ? DialScriptCompiler.ParseLines(source.Source.Lines) : null;
+        return ValueTask.FromResult(new ParsedFile(source.Index, source.Path, source.Source, parsedLines, source.Error));
+    }
+    
+    private Func<ParsedFile, ValueTask<CompiledFile>> CreateValidator()
+    {
+        // Compiler reuses its validation state between files, so every validator worker gets its own instance
+        var settings = _settings.Clone();
+        settings.Quiet = true;
+        settings.Verbose = false;
+        var compiler = new DialScriptCompiler(settings);
+        
+        return file =>
+        {
+            var result = file.Source == null || file.ParsedLines == null
+                ? DialScriptCompiler.ReadFailed(file.Path, file.Error!)
+                : compiler.Compile(file.Path, file.Source.Lines, file.ParsedLines, file.Source.LineIndex);
+            
+            FixWriter.Apply(file.Path, result.Fixes);
+            ScriptExport.Write(result, settings);
+            
+            return ValueTask.FromResult(new CompiledFile(file.Index, result));
+        };
+    }
+    
+    // Every validator collects its results in its own buffer, so workers never contend on output
+    private async Task<List<CompiledFile>[]> RunBufferedValidators(ChannelReader<ParsedFile> input,
+        CancellationToken cancellationToken)
+    {
+        var buffers = new List<CompiledFile>[Math.Max(1, _pipelineSettings.Validators)];
+        var tasks = new Task[buffers.Length];
+        for (var i = 0; i < tasks.Length; i++)
+        {
+            var buffer = buffers[i] = new List<CompiledFile>();
+            tasks[i] = Task.Run(async () =>
+            {
+                var validate = CreateValidator();
+                await foreach (var file in input.ReadAllAsync(cancellationToken))
+                {
+                    // Buffers live until every file is done, so only the diagnostics are kept
+                    var compiled = await validate(file);
+                    buffer.Add(compiled with { Result = compiled.Result.Detach() });
+                }
+                
+                buffer.Sort((a, b) => a.Index.CompareTo(b.Index));
+            }, cancellationToken);
+        }
+        
+        await Task.WhenAll(tasks);
+        return buffers;
+    }
+    
+    // K-way merge of sorted worker buffers by file index (= path order)
+    private static IEnumerable<CompiledFile> Merge(List<CompiledFile>[] buffers)
+    {
+        var positions = new int[buffers.Length];
+        var queue = new PriorityQueue<int, int>(buffers.Length);
+        for (var i = 0; i < buffers.Length; i++)
+        {
+            if (buffers[i].Count > 0)
+            {
+                queue.Enqueue(i, buffers[i][0].Index);
+            }
+        }
+        
+        while (queue.TryDequeue(out var bufferIndex, out _))
+        {
+            var buffer = buffers[bufferIndex];
+            yield return buffer[positions[bufferIndex]++];
+            
+            if (positions[bufferIndex] < buffer.Count)
+            {
+                queue.Enqueue(bufferIndex, buffer[positions[bufferIndex]].Index);
+            }
+        }
+    }
+    
+    // Streaming mode: holds back results that finished early until all earlier files are printed
+    private async Task WriteInOrderAsync(ChannelReader<CompiledFile> input, PipelineSummary summary,
+        CancellationToken cancellationToken)
+    {
+        var pending = new Dictionary<int, CompileResult>();
+        var next = 0;
+        
+        await foreach (var file in input.ReadAllAsync(cancellationToken))
+        {
+            pending.Add(file.Index, file.Result);
+            while (pending.Remove(next, out var result))
+            {
+                Emit(result, summary);
+                next++;
+            }
+        }
+    }
+    
+    private void Emit(CompileResult result, PipelineSummary summary)
+    {
+        summary.Files++;
+        summary.TotalLines += result.TotalLines;
+        summary.Errors += result.ErrorCount;
+        
+        // Errors of one file are already in line order, the compiler validates lines sequentially
+        if (!_settings.Quiet && (result.ErrorCount > 0 || result.Fixes.Count > 0 || _settings.Verbose))
+        {
+            ConsoleOutput.PrintResult(result);
+        }
+        
+        // Last stage to look at the result, its buffers go back to the pool
+        result.Dispose();
+    }
+}
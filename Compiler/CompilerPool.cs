@@ -0,0 +1,38 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using DialScript.Parsing;
+
+namespace DialScript.Compiler;
+
+// Compilers for hosts that validate scripts continuously and concurrently (e.g. a server).
+// A compiler handles one file at a time, so each request rents one and gives it back.
+// Dispose the returned CompileResult to hand its buffers back as well
+public sealed class CompilerPool
+{
+    private readonly ObjectPool<DialScriptCompiler> _compilers;
+
+    public CompilerPool(CompilerSettings settings, int maxRetained = 0)
+    {
+        _compilers = new ObjectPool<DialScriptCompiler>(() => new DialScriptCompiler(settings), c => c.Reset(),
+            maxRetained);
+    }
+
+    public DialScriptCompiler Rent() => _compilers.Rent();
+
+    public void Return(DialScriptCompiler compiler) => _compilers.Return(compiler);
+
+    public CompileResult Compile(string filePath, SourceText source)
+    {
+        var compiler = Rent();
+        try
+        {
+            return compiler.Compile(filePath, source);
+        }
+        finally
+        {
+            Return(compiler);
+        }
+    }
+}
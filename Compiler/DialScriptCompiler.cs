@@ -1,81 +1,276 @@
+using System.Buffers;
+using DialScript.Compiler.Rules;
+using DialScript.Export;
+using DialScript.Formatting;
 using DialScript.Models;
 using DialScript.Output;
 using DialScript.Parsing;
+using DialScript.Schema;
 
 namespace DialScript.Compiler;
 
 public class CompilerSettings
 {
     public bool Verbose { get; set; } = false;
+    
+    // Don't print diagnostics and summary, the caller renders the result
+    public bool Quiet { get; set; } = false;
+    
+    // Stop compiling a file after this many errors (0 = no limit)
+    public int MaxErrors { get; set; } = 0;
+    
+    // Report repeated identical errors once, with a count
+    public bool CollapseErrors { get; set; } = false;
+    
+    // Fix errors with an obvious fix (see DiagnosticFixes) and validate the fixed lines instead
+    public bool ApplyFixes { get; set; } = false;
+    
+    // Report dialog text longer than this (0 = no limit)
+    public int MaxLineLength { get; set; } = 0;
+    
+    // Allowed line metadata (--schema), null = anything goes
+    public MetadataSchema? Schema { get; set; }
+    
+    // Terms dialog text must not contain (--banned), null = no check
+    public TermMatcher? BannedTerms { get; set; }
+    
+    // Word list to check dialog text against (--dictionary, --allow), null = no spell check
+    public SpellChecker? Spelling { get; set; }
+    
+    // Text box and font widths to lay dialog text out against (--layout), null = no layout
+    public TextLayout? Layout { get; set; }
+    
+    // Extra output written next to every compiled script (--emit)
+    public EmitTarget Emit { get; set; } = EmitTarget.None;
+    
+    public GraphFormat GraphFormat { get; set; } = GraphFormat.Dot;
+    
+    // Files pulled in with 'Include:', loaded once per run and shared by clones
+    public IncludeCache Includes { get; set; } = new();
+    
+    // Project-specific rules, run after the built-in ones
+    public List<ValidationRule> Rules { get; private set; } = new();
+    
+    public CompilerSettings Clone()
+    {
+        var clone = (CompilerSettings)MemberwiseClone();
+        clone.Rules = new List<ValidationRule>(Rules);
+        return clone;
+    }
 }
 
-public class CompileResult
+// Owns pooled buffers: dispose it once the diagnostics have been used, and don't touch
+// Errors, Fixes or ParsedLines afterwards
+public class CompileResult : IDisposable
 {
+    private static readonly ObjectPool<List<CompileError>> ErrorLists = new(() => new(), l => l.Clear());
+    private static readonly ObjectPool<List<TextEdit>> FixLists = new(() => new(), l => l.Clear());
+    
+    private ParsedLine[] _parsedLines = [];
+    private int _parsedCount;
+    private bool _ownsParsedLines;
+    
+    public string FilePath { get; set; } = string.Empty;
 
     public bool Success => Errors.Count == 0;
     
     public int TotalLines { get; set; }
     
-    public List<CompileError> Errors { get; } = new();
-
-    public List<ParsedLine> ParsedLines { get; } = new();
+    // True if compilation stopped early because of MaxErrors
+    public bool Stopped { get; set; }
+    
+    // Number of reported errors, including the collapsed repeats
+    public int ErrorCount
+    {
+        get
+        {
+            var count = 0;
+            foreach (var error in Errors)
+            {
+                count += error.Count;
+            }
+            return count;
+        }
+    }
+    
+    public List<CompileError> Errors { get; private set; } = ErrorLists.Rent();
+    
+    // Lines that were validated (all of them, unless Stopped)
+    public ReadOnlySpan<ParsedLine> ParsedLines => _parsedLines.AsSpan(0, _parsedCount);
+    
+    // Edits applied in ApplyFixes mode, to be written back with FixWriter
+    public List<TextEdit> Fixes { get; private set; } = FixLists.Rent();
+    
+    // Errors fixed by the edits, a line with several errors is one edit
+    public int FixedCount { get; set; }
+    
+    // Converts error spans and offsets, null if the file couldn't be read
+    public LineIndex? LineIndex { get; set; }
+    
+    // Line table for a compile that parses on its own, returned to the pool on Dispose
+    internal ParsedLine[] RentParsedLines(int count)
+    {
+        _parsedLines = ArrayPool<ParsedLine>.Shared.Rent(count);
+        Array.Clear(_parsedLines, 0, count);
+        _ownsParsedLines = true;
+        return _parsedLines;
+    }
+    
+    internal void SetParsedLines(ParsedLine[] parsedLines, int count)
+    {
+        _parsedLines = parsedLines;
+        _parsedCount = count;
+    }
+    
+    // Copy with only what printing needs (path, counts, diagnostics and fixes). This result is
+    // disposed, so a caller that keeps results until the end doesn't hold on to line tables
+    public CompileResult Detach()
+    {
+        var copy = new CompileResult
+        {
+            FilePath = FilePath,
+            TotalLines = TotalLines,
+            Stopped = Stopped,
+            FixedCount = FixedCount
+        };
+        copy.Errors.AddRange(Errors);
+        copy.Fixes.AddRange(Fixes);
+        Dispose();
+        return copy;
+    }
+    
+    public void Dispose()
+    {
+        if (_ownsParsedLines)
+        {
+            ArrayPool<ParsedLine>.Shared.Return(_parsedLines, clearArray: true);
+            _ownsParsedLines = false;
+        }
+        _parsedLines = [];
+        _parsedCount = 0;
+        
+        ErrorLists.Return(Errors);
+        FixLists.Return(Fixes);
+        Errors = [];
+        Fixes = [];
+    }
 }
 
+// Compiles one file at a time and reuses its validation state between files, see CompilerPool
+// for concurrent use
 public class DialScriptCompiler
 {
+    // Every fix removes one error of a line, the limit stops a fix that doesn't help
+    private const int MaxFixesPerLine = 8;
+    
     private readonly CompilerSettings _settings;
     
-    private bool _hasScene;
-    private bool _hasLevel;
-    private bool _hasLocation;
-    private bool _hasCharacters;
-    private bool _inDialog;
-    private int _currentScene;
-    private HashSet<string> _knownCharacters = new();
+    private readonly RuleSet _rules;
+    
+    private readonly ValidationContext _context;
     
     public DialScriptCompiler(CompilerSettings? settings = null)
     {
         _settings = settings ?? new CompilerSettings();
+        _rules = RuleSet.Create(_settings);
+        _context = new ValidationContext(_settings);
+    }
+    
+    // Drops everything kept from the last compile, so a pooled compiler doesn't hold on to it
+    public void Reset()
+    {
+        _context.Reset();
     }
 
     public CompileResult Compile(string filePath)
     {
-        var result = new CompileResult();
-        
         // Check file exists
         if (!File.Exists(filePath))
         {
             ConsoleOutput.PrintErrorMessage($"cannot open file {filePath}. Does it exist?");
-            result.Errors.Add(new CompileError
-            {
-                LineNumber = 0,
-                Message = $"File not found: {filePath}"
-            });
-            return result;
+            return FileNotFound(filePath);
         }
         
         // Read file
-        var lines = File.ReadAllLines(filePath);
-        result.TotalLines = lines.Length;
-        
+        SourceText source;
+        try
+        {
+            source = SourceText.Load(filePath);
+        }
+        catch (Exception e) when (e is IOException or UnauthorizedAccessException)
+        {
+            ConsoleOutput.PrintErrorMessage($"cannot read file {filePath}: {e.Message}");
+            return ReadFailed(filePath, e);
+        }
+        return Compile(filePath, source);
+    }
+    
+    // Compiles text that was already read (e.g. from stdin), filePath is only used for output
+    public CompileResult Compile(string filePath, SourceText source)
+    {
         if (_settings.Verbose)
         {
             ConsoleOutput.PrintHeader(filePath);
         }
         
-        ResetState();
+        return Compile(filePath, source.Lines, lineIndex: source.LineIndex);
+    }
+    
+    // Validates the lines. Already parsed lines can be passed in, so callers can read and parse
+    // on other threads; otherwise lines are parsed on the go, so --max-errors skips the rest
+    public CompileResult Compile(string filePath, string[] lines, ParsedLine[]? parsedLines = null, 
+        LineIndex? lineIndex = null)
+    {
+        lineIndex ??= LineIndex.FromLines(lines);
+        var result = new CompileResult
+        {
+            FilePath = filePath,
+            TotalLines = lines.Length,
+            LineIndex = lineIndex
+        };
+        parsedLines ??= result.RentParsedLines(lines.Length);
+        
+        if (_settings.ApplyFixes)
+        {
+            // Edits are written at byte offsets of the file, which only a UTF-8 file has
+            if (lineIndex.IsFileOffsets)
+            {
+                result.FixedCount = FixLines(lines, parsedLines, lineIndex, result.Fixes);
+            }
+            else
+            {
+                var error = new CompileError(DiagnosticCode.FixesNotApplied, default, argument: filePath);
+                result.Errors.Add(error);
+                if (!_settings.Quiet && !_settings.CollapseErrors)
+                {
+                    ConsoleOutput.PrintError(error);
+                }
+            }
+        }
+        
+        var context = _context;
+        context.Reset(filePath, lineIndex, parsedLines, result.Errors);
         
-        // Parse lines
+        var validated = 0;
         for (var i = 0; i < lines.Length; i++)
         {
-            var lineNumber = i + 1;
-            var line = lines[i];
-            
-            var parsed = LineParser.Parse(line, lineNumber);
-            result.ParsedLines.Add(parsed);
+            // Parse current line and the next one (empty line check looks ahead)
+            var parsed = parsedLines[i] ??= LineParser.Parse(lines[i], i + 1);
+            if (i + 1 < lines.Length)
+            {
+                parsedLines[i + 1] ??= LineParser.Parse(lines[i + 1], i + 2);
+            }
+            validated++;
             
             // Check for errors in context
-            ValidateLine(parsed, lines, i, result.Errors);
+            context.Index = i;
+            _rules.Validate(parsed, context);
+            
+            if (context.IsErrorLimitReached)
+            {
+                result.Stopped = true;
+                break;
+            }
             
             // Print parsed line in verbose mode
             if (_settings.Verbose)
@@ -85,346 +280,106 @@ public class DialScriptCompiler
         }
         
         // Check for final requirements
-        ValidateFinalRequirements(lines.Length, result.Errors);
-        
-        // Print summary
-        if (_settings.Verbose)
+        if (!result.Stopped)
         {
-            ConsoleOutput.PrintFooter(result.TotalLines, result.Errors.Count);
+            _rules.Finish(context);
         }
-        else
+        result.SetParsedLines(parsedLines, validated);
+        
+        // Print collapsed errors (their counts are only known now) and summary
+        if (!_settings.Quiet)
         {
-            ConsoleOutput.PrintFooter(result.TotalLines, result.Errors.Count);
+            if (_settings.CollapseErrors)
+            {
+                foreach (var error in result.Errors)
+                {
+                    ConsoleOutput.PrintError(error);
+                }
+            }
+            if (result.FixedCount > 0)
+            {
+                ConsoleOutput.PrintFixed(result.FixedCount);
+            }
+            ConsoleOutput.PrintFooter(result.TotalLines, result.ErrorCount, result.Stopped);
         }
         
         return result;
     }
     
-    private void ResetState()
+    public static ParsedLine[] ParseLines(string[] lines)
     {
-        _hasScene = false;
-        _hasLevel = false;
-        _hasLocation = false;
-        _hasCharacters = false;
-        _inDialog = false;
-        _currentScene = 0;
-        _knownCharacters.Clear();
+        var parsedLines = new ParsedLine[lines.Length];
+        for (var i = 0; i < lines.Length; i++)
+        {
+            parsedLines[i] = LineParser.Parse(lines[i], i + 1);
+        }
+        return parsedLines;
     }
     
-    private void ValidateLine(ParsedLine parsed, string[] lines, int index, List<CompileError> errors)
+    public static CompileResult FileNotFound(string filePath)
     {
-        var lineNumber = index + 1;
-        var originalLine = lines[index];
-        
-        switch (parsed.Type)
-        {
-            // Default lines
-            case LineType.Empty:
-                // Check for empty lines between dialog lines
-                if (_inDialog && index + 1 < lines.Length)
-                {
-                    var nextParsed = LineParser.Parse(lines[index + 1], lineNumber + 1);
-                    if (nextParsed.Type != LineType.DialogHeader && 
-                        nextParsed.Type != LineType.Comment &&
-                        !nextParsed.Type.ToString().StartsWith("Error"))
-                    {
-                        AddError(errors, lineNumber, 
-                            "Empty line inside dialog block", 
-                            "remove empty lines between dialog lines", 
-                            originalLine);
-                    }
-                }
-                break;
-                
-            case LineType.Scene:
-                if (_hasScene)
-                {
-                    AddError(errors, lineNumber, 
-                        "Only one [Scene.X] allowed", 
-                        "remove extra scene declarations", 
-                        originalLine);
-                }
-                else if (parsed.Number <= 0)
-                {
-                    AddError(errors, lineNumber, 
-                        "Scene number must be > 0", 
-                        "use [Scene.1], [Scene.2], etc.", 
-                        originalLine, 7);
-                }
-                else
-                {
-                    _currentScene = parsed.Number;
-                    _inDialog = false;
-                    _knownCharacters.Clear();
-                    _hasScene = true;
-                }
-                break;
-                
-            case LineType.DialogHeader:
-                if (_currentScene == 0)
-                {
-                    AddError(errors, lineNumber, 
-                        "Dialog without [Scene.X]", 
-                        "add [Scene.1] before this dialog", 
-                        originalLine);
-                }
-                else if (parsed.Number <= 0)
-                {
-                    AddError(errors, lineNumber, 
-                        "Dialog number must be > 0", 
-                        "use [Dialog.1], [Dialog.2], etc.", 
-                        originalLine, 8);
-                }
-                else
-                {
-                    _inDialog = true;
-                }
-                break;
-                
-            case LineType.Level:
-                if (_currentScene == 0)
-                {
-                    AddError(errors, lineNumber, 
-                        "Level outside scene", 
-                        "move Level: x inside [Scene.X] block", 
-                        originalLine);
-                }
-                else if (_inDialog)
-                {
-                    AddError(errors, lineNumber, 
-                        "Level after dialog", 
-                        "move Level: x before [Dialog.X]", 
-                        originalLine);
-                }
-                else if (_hasLevel)
-                {
-                    AddError(errors, lineNumber, 
-                        "Duplicate Level", 
-                        "remove extra Level definition", 
-                        originalLine);
-                }
-                else
-                {
-                    _hasLevel = true;
-                }
-                break;
-                
-            case LineType.Location:
-                if (_currentScene == 0)
-                {
-                    AddError(errors, lineNumber, 
-                        "Location outside scene", 
-                        "move Location: x inside [Scene.X] block", 
-                        originalLine);
-                }
-                else if (_inDialog)
-                {
-                    AddError(errors, lineNumber, 
-                        "Location after dialog", 
-                        "move Location: x before [Dialog.X]", 
-                        originalLine);
-                }
-                else if (_hasLocation)
-                {
-                    AddError(errors, lineNumber, 
-                        "Duplicate Location", 
-                        "remove extra Location definition", 
-                        originalLine);
-                }
-                else
-                {
-                    _hasLocation = true;
-                }
-                break;
-                
-            case LineType.Characters:
-                if (_currentScene == 0)
-                {
-                    AddError(errors, lineNumber, 
-                        "Characters outside scene", 
-                        "move Characters: inside [Scene.X] block", 
-                        originalLine);
-                }
-                else if (_inDialog)
-                {
-                    AddError(errors, lineNumber, 
-                        "Characters after dialog", 
-                        "move Characters: before [Dialog.X]", 
-                        originalLine);
-                }
-                else if (_hasCharacters)
-                {
-                    AddError(errors, lineNumber, 
-                        "Duplicate Characters", 
-                        "remove extra Characters definition", 
-                        originalLine);
-                }
-                else
-                {
-                    // Parse known characters
-                    if (!string.IsNullOrEmpty(parsed.Value))
-                    {
-                        _knownCharacters = parsed.Value
-                            .Split(',')
-                            .Select(c => c.Trim())
-                            .Where(c => !string.IsNullOrEmpty(c))
-                            .ToHashSet();
-                    }
-                    _hasCharacters = true;
-                }
-                break;
-                
-            case LineType.Dialog:
-                if (!_inDialog)
-                {
-                    AddError(errors, lineNumber, 
-                        "Stray dialog line", 
-                        "add [Dialog.1] before this line", 
-                        originalLine);
-                }
-                else
-                {
-                    // Check for known characters
-                    if (_knownCharacters.Count > 0 && 
-                        !string.IsNullOrEmpty(parsed.CharacterName) &&
-                        !_knownCharacters.Contains(parsed.CharacterName))
-                    {
-                        AddError(errors, lineNumber, 
-                            "Unknown character", 
-                            "add this character to Characters", 
-                            originalLine);
-                    }
-                    
-                    // Check for missing metadata brace
-                    if (!string.IsNullOrEmpty(parsed.Metadata) && !parsed.Metadata.Contains('}'))
-                    {
-                        var metaPos = originalLine.IndexOf('{');
-                        AddError(errors, lineNumber, 
-                            "Missing '}' in metadata", 
-                            "close metadata with '}'", 
-                            originalLine, metaPos);
-                    }
-                }
-                break;
-                
-            case LineType.Unknown:
-                if (_inDialog)
-                {
-                    AddError(errors, lineNumber, 
-                        "Invalid line in dialog", 
-                        "use format: Name: Text", 
-                        originalLine);
-                }
-                else
-                {
-                    AddError(errors, lineNumber, 
-                        "Unknown syntax", 
-                        "check spelling or use: [Scene.N], [Dialog.N], Name: Text", 
-                        originalLine);
-                }
-                break;
-            
-            case LineType.ErrorEmptyName:
-                AddError(errors, lineNumber, "Empty name before ':'", "add character name, e.g. Alan: Hello", originalLine);
-                break;
-                
-            case LineType.ErrorMissingColon:
-                AddError(errors, lineNumber, "Missing ':' in dialog", "use format: Name: Text", originalLine);
-                break;
-                
-            case LineType.ErrorInvalidDialogFormat:
-                AddError(errors, lineNumber, "Wrong dialog format", "use format: Name: Text", originalLine);
-                break;
-                
-            case LineType.ErrorTypoScene:
-                AddError(errors, lineNumber, "Did you mean [Scene.N]?", "check spelling", originalLine, 1);
-                break;
-                
-            case LineType.ErrorTypoDialog:
-                AddError(errors, lineNumber, "Did you mean [Dialog.N]?", "check spelling", originalLine, 1);
-                break;
-                
-            case LineType.ErrorTypoLevel:
-                AddError(errors, lineNumber, "Did you mean 'Level:'?", "check spelling", originalLine);
-                break;
-                
-            case LineType.ErrorTypoLocation:
-                AddError(errors, lineNumber, "Did you mean 'Location:'?", "check spelling", originalLine);
-                break;
-                
-            case LineType.ErrorTypoCharacters:
-                AddError(errors, lineNumber, "Did you mean 'Characters:'?", "check spelling", originalLine);
-                break;
-                
-            case LineType.ErrorUnclosedBracket:
-                AddError(errors, lineNumber, "Missing ']'", "close header with ']'", originalLine, originalLine.Length);
-                break;
-                
-            case LineType.ErrorExtraSpaceInHeader:
-                AddError(errors, lineNumber, "Extra space in header", "use [Scene.1] or [Dialog.1] without spaces", originalLine);
-                break;
-                
-            case LineType.ErrorExtraSpaceInMetadata:
-                AddError(errors, lineNumber, "Extra space before ':'", "use 'Level:', 'Location:', 'Characters:' without spaces", originalLine);
-                break;
-                
-            case LineType.ErrorLeadingSpace:
-                AddError(errors, lineNumber, "Leading space in dialog line", "character name must start at the beginning of the line", originalLine);
-                break;
-                
-            case LineType.ErrorNoSpaceAfterColon:
-                AddError(errors, lineNumber, "Missing space after ':'", "add a space after the colon, e.g. 'Name: Text'", originalLine);
-                break;
-                
-            case LineType.ErrorEmptyText:
-                AddError(errors, lineNumber, "Empty dialog text", "add text after the colon", originalLine);
-                break;
-        }
+        var result = new CompileResult { FilePath = filePath };
+        result.Errors.Add(new CompileError(DiagnosticCode.FileNotFound, default, argument: filePath));
+        return result;
     }
-
-    private void ValidateFinalRequirements(int totalLines, List<CompileError> errors)
+    
+    // A file that is gone is reported as not found, anything else (too large, no access) as it is
+    public static CompileResult ReadFailed(string filePath, Exception error)
     {
-        if (!_hasScene)
-        {
-            AddError(errors, totalLines, 
-                "Missing [Scene.X]", 
-                "add [Scene.1] at the beginning of file");
-        }
-        if (!_hasLevel)
-        {
-            AddError(errors, totalLines, 
-                "Missing Level", 
-                "add 'Level: N' after [Scene.X]");
-        }
-        if (!_hasLocation)
-        {
-            AddError(errors, totalLines, 
-                "Missing Location", 
-                "add 'Location: name' after [Scene.X]");
-        }
-        if (!_hasCharacters)
+        if (error is FileNotFoundException or DirectoryNotFoundException)
         {
-            AddError(errors, totalLines, 
-                "Missing Characters", 
-                "add 'Characters: Name1, Name2' after [Scene.X]");
+            return FileNotFound(filePath);
         }
+        
+        var result = new CompileResult { FilePath = filePath };
+        result.Errors.Add(new CompileError(DiagnosticCode.ReadFailed, default, argument: error.Message));
+        return result;
     }
-
-    private void AddError(List<CompileError> errors, int lineNumber, string message, 
-        string? hint = null, string? lineContent = null, int errorPosition = -1)
+    
+    // Replaces every fixable error line with its fixed version, so the rest of the compilation
+    // reports what a compile of the fixed file would report, without compiling twice.
+    // Returns the number of fixed errors
+    private static int FixLines(string[] lines, ParsedLine[] parsedLines, LineIndex lineIndex, List<TextEdit> fixes)
     {
-        errors.Add(new CompileError
+        var fixedCount = 0;
+        for (var i = 0; i < lines.Length; i++)
         {
-            LineNumber = lineNumber,
-            Message = message,
-            Hint = hint,
-            LineContent = lineContent,
-            ErrorPosition = errorPosition
-        });
-        
-        ConsoleOutput.PrintError(lineNumber, message, hint, lineContent, errorPosition);
+            var parsed = parsedLines[i] ??= LineParser.Parse(lines[i], i + 1);
+            
+            // A fixed line can show the next error of the same line ("  Alan:Hi" has a leading
+            // space, then no space after ':'), so fixes are applied until none is left
+            var text = parsed.OriginalContent;
+            var count = 0;
+            while (parsed.IsError && count < MaxFixesPerLine && DiagnosticFixes.TryCreate(parsed, out var range, out var newText))
+            {
+                text = DiagnosticFixes.Apply(text, range, newText);
+                parsed = LineParser.Parse(text, i + 1);
+                count++;
+            }
+            
+            if (count == 0)
+            {
+                continue;
+            }
+            
+            // One edit for the part of the line that changed
+            var original = parsedLines[i].OriginalContent;
+            var prefix = original.AsSpan().CommonPrefixLength(text);
+            var suffix = 0;
+            while (suffix < original.Length - prefix && suffix < text.Length - prefix &&
+                   original[^(suffix + 1)] == text[^(suffix + 1)])
+            {
+                suffix++;
+            }
+            var changed = new ColumnRange(prefix, original.Length - suffix);
+            fixes.Add(new TextEdit(lineIndex.GetSpan(i + 1, changed), text[prefix..(text.Length - suffix)]));
+            
+            parsedLines[i] = parsed;
+            fixedCount += count;
+        }
+        return fixedCount;
     }
-
+    
     private void PrintParsedLine(ParsedLine parsed)
     {
         switch (parsed.Type)
@@ -457,6 +412,10 @@ public class DialScriptCompiler
                 ConsoleOutput.PrintCharacters(parsed.LineNumber, parsed.Value ?? "");
                 break;
                 
+            case LineType.Include:
+                ConsoleOutput.PrintInclude(parsed.LineNumber, parsed.Value ?? "");
+                break;
+                
             case LineType.Dialog:
                 ConsoleOutput.PrintDialogLine(parsed.LineNumber, 
                     parsed.CharacterName ?? "", 
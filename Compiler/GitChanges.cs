@@ -0,0 +1,85 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Diagnostics;
+using DialScript.Output;
+
+namespace DialScript.Compiler;
+
+// Asks the local git repository which .ds files changed since a revision
+public static class GitChanges
+{
+    public static bool TryGetChangedFiles(string since, out List<string> files)
+    {
+        files = [];
+
+        // Added, copied, modified and renamed files (new path) relative to the current directory,
+        // deleted files are skipped because there is nothing left to compile
+        if (!TryRunGit(["diff", "--name-only", "-z", "--relative", "-M", "--diff-filter=ACMRT", since, "--", "*.ds"], out var changed))
+        {
+            return false;
+        }
+
+        // New files that are not tracked yet
+        if (!TryRunGit(["ls-files", "-z", "--others", "--exclude-standard", "--", "*.ds"], out var untracked))
+        {
+            return false;
+        }
+
+        foreach (var path in changed.Concat(untracked))
+        {
+            if (File.Exists(path))
+            {
+                files.Add(path);
+            }
+        }
+
+        return true;
+    }
+
+    private static bool TryRunGit(string[] arguments, out List<string> paths)
+    {
+        paths = [];
+
+        var startInfo = new ProcessStartInfo("git")
+        {
+            RedirectStandardOutput = true,
+            RedirectStandardError = true,
+            UseShellExecute = false
+        };
+        foreach (var argument in arguments)
+        {
+            startInfo.ArgumentList.Add(argument);
+        }
+
+        Process process;
+        try
+        {
+            process = Process.Start(startInfo)!;
+        }
+        catch (Exception e) when (e is System.ComponentModel.Win32Exception or InvalidOperationException)
+        {
+            ConsoleOutput.PrintErrorMessage("cannot run git. Is it installed?");
+            return false;
+        }
+
+        using (process)
+        {
+            var stderr = process.StandardError.ReadToEndAsync();
+            var output = process.StandardOutput.ReadToEnd();
+            process.WaitForExit();
+
+            if (process.ExitCode != 0)
+            {
+                ConsoleOutput.PrintErrorMessage($"git {arguments[0]} failed: {stderr.Result.Trim()}");
+                return false;
+            }
+
+            // -z separates paths with NUL and leaves them unquoted
+            paths.AddRange(output.Split('\0', StringSplitOptions.RemoveEmptyEntries));
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,48 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Collections.Concurrent;
+
+namespace DialScript.Compiler;
+
+// Small thread-safe pool of reusable objects. Returned objects are reset and kept up to
+// maxRetained, anything beyond that is left to the GC
+public sealed class ObjectPool<T> where T : class
+{
+    private readonly ConcurrentQueue<T> _items = new();
+    private readonly Func<T> _create;
+    private readonly Action<T>? _reset;
+    private readonly int _maxRetained;
+    private int _count;
+
+    public ObjectPool(Func<T> create, Action<T>? reset = null, int maxRetained = 0)
+    {
+        _create = create;
+        _reset = reset;
+        _maxRetained = maxRetained > 0 ? maxRetained : Environment.ProcessorCount * 2;
+    }
+
+    public T Rent()
+    {
+        if (_items.TryDequeue(out var item))
+        {
+            Interlocked.Decrement(ref _count);
+            return item;
+        }
+        return _create();
+    }
+
+    public void Return(T item)
+    {
+        _reset?.Invoke(item);
+        if (Interlocked.Increment(ref _count) <= _maxRetained)
+        {
+            _items.Enqueue(item);
+        }
+        else
+        {
+            Interlocked.Decrement(ref _count);
+        }
+    }
+}
@@ -0,0 +1,31 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using DialScript.Models;
+using DialScript.Parsing;
+
+namespace DialScript.Compiler.Rules;
+
+// Dialog text containing a term of the banned list (--banned), all terms in one pass per line
+public sealed class BannedTermRule : ValidationRule
+{
+    private readonly TermMatcher _terms;
+    
+    public BannedTermRule(TermMatcher terms)
+    {
+        _terms = terms;
+    }
+    
+    public override IReadOnlyList<LineType> LineTypes { get; } = [LineType.Dialog];
+    
+    public override void Validate(ParsedLine line, ValidationContext context)
+    {
+        foreach (var match in _terms.Find(line.TextSpan))
+        {
+            // Offsets are into the plain text, a term split by tags marks the tags too
+            var range = line.GetSourceRange(match.Start, match.Length);
+            context.Report(DiagnosticCode.BannedTerm, line, range, range.Start, match.Term);
+        }
+    }
+}
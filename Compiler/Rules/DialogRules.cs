@@ -0,0 +1,207 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Globalization;
+using DialScript.Models;
+using DialScript.Schema;
+
+namespace DialScript.Compiler.Rules;
+
+// Empty lines between dialog lines
+public sealed class EmptyLineRule : ValidationRule
+{
+    public override IReadOnlyList<LineType> LineTypes { get; } = [LineType.Empty];
+    
+    public override void Validate(ParsedLine line, ValidationContext context)
+    {
+        if (context.InDialog && context.Next is { } next &&
+            next.Type != LineType.DialogHeader &&
+            next.Type != LineType.Comment &&
+            !next.IsError)
+        {
+            context.Report(DiagnosticCode.EmptyLineInDialog, line);
+        }
+    }
+}
+
+public sealed class DialogLineRule : ValidationRule
+{
+    public override IReadOnlyList<LineType> LineTypes { get; } = [LineType.Dialog];
+    
+    public override void Validate(ParsedLine line, ValidationContext context)
+    {
+        if (!context.InDialog)
+        {
+            context.Report(DiagnosticCode.StrayDialogLine, line);
+            return;
+        }
+        
+        // Check for known characters
+        if ((context.KnownCharacters.Count > 0 || context.HasIncludedCharacters) && 
+            !string.IsNullOrEmpty(line.CharacterName) &&
+            !context.IsKnownCharacter(line.CharacterName))
+        {
+            context.Report(DiagnosticCode.UnknownCharacter, line, line.NameRange);
+        }
+        
+        // Check for missing metadata brace
+        if (line.HasMetadata && !line.MetadataSpan.Contains('}'))
+        {
+            var metaPos = line.OriginalContent.IndexOf('{');
+            context.Report(DiagnosticCode.MissingMetadataBrace, line, line.MetadataRange, metaPos);
+        }
+    }
+}
+
+public sealed class UnknownLineRule : ValidationRule
+{
+    public override IReadOnlyList<LineType> LineTypes { get; } = [LineType.Unknown];
+    
+    public override void Validate(ParsedLine line, ValidationContext context)
+    {
+        context.Report(context.InDialog ? DiagnosticCode.InvalidLineInDialog : DiagnosticCode.UnknownSyntax, line);
+    }
+}
+
+// Errors found by the parser itself
+public sealed class ParseErrorRule : ValidationRule
+{
+    public override IReadOnlyList<LineType> LineTypes { get; } =
+    [
+        LineType.ErrorEmptyName, LineType.ErrorMissingColon, LineType.ErrorInvalidDialogFormat,
+        LineType.ErrorTypoScene, LineType.ErrorTypoDialog, LineType.ErrorTypoLevel,
+        LineType.ErrorTypoLocation, LineType.ErrorTypoCharacters, LineType.ErrorUnclosedBracket,
+        LineType.ErrorExtraSpaceInHeader, LineType.ErrorExtraSpaceInMetadata, LineType.ErrorLeadingSpace,
+        LineType.ErrorNoSpaceAfterColon, LineType.ErrorEmptyText, LineType.ErrorNumberTooLarge,
+        LineType.ErrorInvalidMarkup
+    ];
+    
+    public override void Validate(ParsedLine line, ValidationContext context)
+    {
+        switch (line.Type)
+        {
+            case LineType.ErrorEmptyName:
+                context.Report(DiagnosticCode.EmptyName, line);
+                break;
+                
+            case LineType.ErrorMissingColon:
+                context.Report(DiagnosticCode.MissingColon, line);
+                break;
+                
+            case LineType.ErrorInvalidDialogFormat:
+                context.Report(DiagnosticCode.InvalidDialogFormat, line);
+                break;
+                
+            case LineType.ErrorTypoScene:
+                context.Report(DiagnosticCode.TypoScene, line, 1);
+                break;
+                
+            case LineType.ErrorTypoDialog:
+                context.Report(DiagnosticCode.TypoDialog, line, 1);
+                break;
+                
+            case LineType.ErrorTypoLevel:
+                context.Report(DiagnosticCode.TypoLevel, line);
+                break;
+                
+            case LineType.ErrorTypoLocation:
+                context.Report(DiagnosticCode.TypoLocation, line);
+                break;
+                
+            case LineType.ErrorTypoCharacters:
+                context.Report(DiagnosticCode.TypoCharacters, line);
+                break;
+                
+            case LineType.ErrorUnclosedBracket:
+                context.Report(DiagnosticCode.UnclosedBracket, line, line.OriginalContent.Length);
+                break;
+                
+            case LineType.ErrorExtraSpaceInHeader:
+                context.Report(DiagnosticCode.ExtraSpaceInHeader, line);
+                break;
+                
+            case LineType.ErrorExtraSpaceInMetadata:
+                context.Report(DiagnosticCode.ExtraSpaceInMetadata, line);
+                break;
+                
+            case LineType.ErrorLeadingSpace:
+                context.Report(DiagnosticCode.LeadingSpace, line);
+                break;
+                
+            case LineType.ErrorNoSpaceAfterColon:
+                context.Report(DiagnosticCode.NoSpaceAfterColon, line);
+                break;
+                
+            case LineType.ErrorEmptyText:
+                context.Report(DiagnosticCode.EmptyText, line);
+                break;
+                
+            case LineType.ErrorInvalidMarkup:
+                context.Report(DiagnosticCode.InvalidMarkup, line, line.ErrorPosition);
+                break;
+                
+            case LineType.ErrorNumberTooLarge:
+                context.Report(DiagnosticCode.HeaderNumberTooLarge, line, line.ValueRange, line.ErrorPosition, 
+                    int.MaxValue.ToString(CultureInfo.InvariantCulture));
+                break;
+        }
+    }
+}
+
+// Optional project rule: limits the length of dialog text (--max-line-length)
+public sealed class LineLengthRule : ValidationRule
+{
+    private readonly int _maxLength;
+    
+    public LineLengthRule(int maxLength)
+    {
+        _maxLength = maxLength;
+    }
+    
+    public override IReadOnlyList<LineType> LineTypes { get; } = [LineType.Dialog];
+    
+    public override void Validate(ParsedLine line, ValidationContext context)
+    {
+        // Markup doesn't count
+        if (line.TextSpan.Length > _maxLength)
+        {
+            context.Report(DiagnosticCode.TextTooLong, line, line.TextRange, line.GetSourceColumn(_maxLength), 
+                _maxLength.ToString());
+        }
+    }
+}
+
+// Dialog text that needs more lines than the text box pages hold (--layout)
+public sealed class TextLayoutRule : ValidationRule
+{
+    private readonly TextLayout _layout;
+    
+    public TextLayoutRule(TextLayout layout)
+    {
+        _layout = layout;
+    }
+    
+    public override IReadOnlyList<LineType> LineTypes { get; } = [LineType.Dialog];
+    
+    public override void Validate(ParsedLine line, ValidationContext context)
+    {
+        // The rule is shared by all compiler threads, the break list belongs to the file's context
+        var breaks = context.LineBreaks;
+        breaks.Clear();
+        var lines = _layout.Break(line.TextSpan, breaks, out var tooWideAt);
+        
+        // Offsets are into the plain text, the caret goes to the same place in the written line
+        if (tooWideAt >= 0)
+        {
+            context.Report(DiagnosticCode.WordTooWide, line, line.TextRange, line.GetSourceColumn(tooWideAt));
+        }
+        
+        if (lines > _layout.MaxLines)
+        {
+            var overflow = breaks[_layout.MaxLines - 1];
+            context.Report(DiagnosticCode.TextOverflow, line, line.TextRange, line.GetSourceColumn(overflow),
+                $"{lines} lines, room for {_layout.MaxLines}");
+        }
+    }
+}
@@ -0,0 +1,44 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using DialScript.Models;
+using DialScript.Parsing;
+
+namespace DialScript.Compiler.Rules;
+
+// Checks '{Key: Value}' line metadata against the project schema (--schema or an included one)
+public sealed class MetadataSchemaRule : ValidationRule
+{
+    public override IReadOnlyList<LineType> LineTypes { get; } = [LineType.Dialog];
+    
+    public override void Validate(ParsedLine line, ValidationContext context)
+    {
+        if (!line.HasMetadata || context.Schema is not { } schema)
+        {
+            return;
+        }
+        
+        var metadata = line.MetadataSpan;
+        foreach (var entry in new MetadataParser(metadata))
+        {
+            if (!schema.TryGetField(entry.Key, out var field))
+            {
+                var range = RangeOf(line, metadata, entry.Key);
+                context.Report(DiagnosticCode.UnknownMetadataKey, line, range, range.Start, entry.Key.ToString());
+            }
+            else if (!field.IsValid(entry.Value))
+            {
+                var range = RangeOf(line, metadata, entry.Value);
+                context.Report(DiagnosticCode.InvalidMetadataValue, line, range, range.Start, $"{field.Key}: {entry.Value}");
+            }
+        }
+    }
+    
+    // Columns of a token that MetadataParser sliced out of line.MetadataSpan
+    private static ColumnRange RangeOf(ParsedLine line, ReadOnlySpan<char> metadata, ReadOnlySpan<char> token)
+    {
+        metadata.Overlaps(token, out var offset);
+        return ColumnRange.Of(line.MetadataRange.Start + offset, token.Length);
+    }
+}
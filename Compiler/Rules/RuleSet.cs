@@ -0,0 +1,79 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using DialScript.Models;
+
+namespace DialScript.Compiler.Rules;
+
+// Rules grouped by the line type they subscribe to, so a line only visits interested rules
+public sealed class RuleSet
+{
+    private static readonly int LineTypeCount = Enum.GetValues<LineType>().Length;
+    
+    private readonly ValidationRule[][] _rulesByType;
+    private readonly ValidationRule[] _rules;
+    
+    public RuleSet(IEnumerable<ValidationRule> rules)
+    {
+        _rules = rules.ToArray();
+        _rulesByType = new ValidationRule[LineTypeCount][];
+        for (var type = 0; type < LineTypeCount; type++)
+        {
+            _rulesByType[type] = _rules.Where(r => r.LineTypes.Contains((LineType)type)).ToArray();
+        }
+    }
+    
+    // Built-in language rules, in the order they run
+    public static IEnumerable<ValidationRule> BuiltIn()
+    {
+        yield return new ParseErrorRule();
+        yield return new EmptyLineRule();
+        yield return new SceneHeaderRule();
+        yield return new DialogHeaderRule();
+        yield return new SceneMetadataRule();
+        yield return new DialogLineRule();
+        yield return new UnknownLineRule();
+        yield return new SceneRequirementsRule();
+    }
+    
+    public static RuleSet Create(CompilerSettings settings)
+    {
+        var rules = BuiltIn().ToList();
+        if (settings.MaxLineLength > 0)
+        {
+            rules.Add(new LineLengthRule(settings.MaxLineLength));
+        }
+        if (settings.BannedTerms != null)
+        {
+            rules.Add(new BannedTermRule(settings.BannedTerms));
+        }
+        if (settings.Spelling != null)
+        {
+            rules.Add(new SpellingRule(settings.Spelling));
+        }
+        if (settings.Layout != null)
+        {
+            rules.Add(new TextLayoutRule(settings.Layout));
+        }
+        rules.Add(new MetadataSchemaRule());
+        rules.AddRange(settings.Rules);
+        return new RuleSet(rules);
+    }
+    
+    public void Validate(ParsedLine line, ValidationContext context)
+    {
+        foreach (var rule in _rulesByType[(int)line.Type])
+        {
+            rule.Validate(line, context);
+        }
+    }
+    
+    public void Finish(ValidationContext context)
+    {
+        foreach (var rule in _rules)
+        {
+            rule.Finish(context);
+        }
+    }
+}
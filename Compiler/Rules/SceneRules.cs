@@ -0,0 +1,202 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using DialScript.Models;
+
+namespace DialScript.Compiler.Rules;
+
+public sealed class SceneHeaderRule : ValidationRule
+{
+    public override IReadOnlyList<LineType> LineTypes { get; } = [LineType.Scene];
+    
+    public override void Validate(ParsedLine line, ValidationContext context)
+    {
+        if (context.HasScene)
+        {
+            context.Report(DiagnosticCode.DuplicateScene, line);
+        }
+        else if (line.Number <= 0)
+        {
+            context.Report(DiagnosticCode.InvalidSceneNumber, line, line.ValueRange, 7);
+        }
+        else
+        {
+            context.CurrentScene = line.Number;
+            context.InDialog = false;
+            context.KnownCharacters.Clear();
+            context.HasScene = true;
+        }
+    }
+}
+
+public sealed class DialogHeaderRule : ValidationRule
+{
+    public override IReadOnlyList<LineType> LineTypes { get; } = [LineType.DialogHeader];
+    
+    public override void Validate(ParsedLine line, ValidationContext context)
+    {
+        if (context.CurrentScene == 0)
+        {
+            context.Report(DiagnosticCode.DialogWithoutScene, line);
+        }
+        else if (line.Number <= 0)
+        {
+            context.Report(DiagnosticCode.InvalidDialogNumber, line, line.ValueRange, 8);
+        }
+        else
+        {
+            context.InDialog = true;
+        }
+    }
+}
+
+// Level, Location and Characters: inside the scene, before dialogs, only once
+public sealed class SceneMetadataRule : ValidationRule
+{
+    public override IReadOnlyList<LineType> LineTypes { get; } = 
+        [LineType.Level, LineType.Location, LineType.Characters, LineType.Include];
+    
+    public override void Validate(ParsedLine line, ValidationContext context)
+    {
+        switch (line.Type)
+        {
+            case LineType.Level:
+                if (CheckOnce(line, context, context.HasLevel, DiagnosticCode.LevelOutsideScene, 
+                        DiagnosticCode.LevelAfterDialog, DiagnosticCode.DuplicateLevel))
+                {
+                    context.HasLevel = true;
+                }
+                break;
+                
+            case LineType.Location:
+                if (CheckOnce(line, context, context.HasLocation, DiagnosticCode.LocationOutsideScene, 
+                        DiagnosticCode.LocationAfterDialog, DiagnosticCode.DuplicateLocation))
+                {
+                    context.HasLocation = true;
+                }
+                break;
+                
+            case LineType.Characters:
+                if (CheckOnce(line, context, context.HasCharacters, DiagnosticCode.CharactersOutsideScene, 
+                        DiagnosticCode.CharactersAfterDialog, DiagnosticCode.DuplicateCharacters))
+                {
+                    // Parse known characters (into the context's set, which is reused across files)
+                    if (!string.IsNullOrEmpty(line.Value))
+                    {
+                        context.KnownCharacters.Clear();
+                        foreach (var name in line.Value.Split(',', StringSplitOptions.TrimEntries | StringSplitOptions.RemoveEmptyEntries))
+                        {
+                            context.KnownCharacters.Add(name);
+                        }
+                    }
+                    context.HasCharacters = true;
+                }
+                break;
+                
+            case LineType.Include:
+                if (Check(line, context, DiagnosticCode.IncludeOutsideScene, DiagnosticCode.IncludeAfterDialog))
+                {
+                    Include(line, context);
+                }
+                break;
+        }
+    }
+    
+    // Paths are relative to the including file
+    private static void Include(ParsedLine line, ValidationContext context)
+    {
+        var directory = Path.GetDirectoryName(Path.GetFullPath(context.FilePath)) ?? ".";
+        var path = Path.Combine(directory, line.Value!);
+        
+        if (!context.Settings.Includes.TryGet(path, out var include, out var error))
+        {
+            context.Report(DiagnosticCode.InvalidInclude, line, line.ValueRange, line.ValueRange.Start, error);
+            return;
+        }
+        
+        context.Includes.Add(include!);
+        if (include!.Schema == null || include.Schema == context.Schema)
+        {
+            return;
+        }
+        
+        // Schemas of several includes (and --schema) are merged, a key declared differently is an error
+        if (context.Schema == null)
+        {
+            context.Schema = include.Schema;
+        }
+        else if (context.Settings.Includes.TryMerge(context.Schema, include, out var merged, out var conflict))
+        {
+            context.Schema = merged;
+        }
+        else
+        {
+            context.Report(DiagnosticCode.SchemaConflict, line, line.ValueRange, line.ValueRange.Start, conflict);
+        }
+    }
+    
+    // Inside the scene and before dialogs
+    private static bool Check(ParsedLine line, ValidationContext context, 
+        DiagnosticCode outsideScene, DiagnosticCode afterDialog)
+    {
+        if (context.CurrentScene == 0)
+        {
+            context.Report(outsideScene, line);
+        }
+        else if (context.InDialog)
+        {
+            context.Report(afterDialog, line);
+        }
+        else
+        {
+            return true;
+        }
+        return false;
+    }
+    
+    // Same, and only once per scene
+    private static bool CheckOnce(ParsedLine line, ValidationContext context, bool alreadyDefined, 
+        DiagnosticCode outsideScene, DiagnosticCode afterDialog, DiagnosticCode duplicate)
+    {
+        if (!Check(line, context, outsideScene, afterDialog))
+        {
+            return false;
+        }
+        if (alreadyDefined)
+        {
+            context.Report(duplicate, line);
+            return false;
+        }
+        return true;
+    }
+}
+
+public sealed class SceneRequirementsRule : ValidationRule
+{
+    public override IReadOnlyList<LineType> LineTypes { get; } = [];
+    
+    public override void Validate(ParsedLine line, ValidationContext context)
+    {
+    }
+    
+    public override void Finish(ValidationContext context)
+    {
+        if (!context.HasScene)
+        {
+            context.ReportAtEnd(DiagnosticCode.MissingScene);
+        }
+        if (!context.HasLevel)
+        {
+            context.ReportAtEnd(DiagnosticCode.MissingLevel);
+        }
+        if (!context.HasLocation)
+        {
+            context.ReportAtEnd(DiagnosticCode.MissingLocation);
+        }
+        if (!context.HasCharacters && !context.HasIncludedCharacters)
+        {
+            context.ReportAtEnd(DiagnosticCode.MissingCharacters);
+        }
+    }
+}
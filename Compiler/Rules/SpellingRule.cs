@@ -0,0 +1,124 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using DialScript.Models;
+using DialScript.Parsing;
+
+namespace DialScript.Compiler.Rules;
+
+// Words of dialog text that are neither in the word list (--dictionary, --allow) nor a known
+// character, with the closest known words as suggestions. Suggestions are looked up only for
+// errors that get rendered, not for the ones cut by --quiet, --collapse or --max-errors
+public sealed class SpellingRule : ValidationRule, IArgumentFormatter
+{
+    private readonly SpellChecker _spelling;
+    
+    public SpellingRule(SpellChecker spelling)
+    {
+        _spelling = spelling;
+    }
+    
+    public override IReadOnlyList<LineType> LineTypes { get; } = [LineType.Dialog];
+    
+    public override void Validate(ParsedLine line, ValidationContext context)
+    {
+        var text = line.TextSpan;
+        var position = 0;
+        while (TryReadWord(text, ref position, out var start, out var length))
+        {
+            var word = text.Slice(start, length);
+            if (!IsChecked(word) || IsKnown(word, context))
+            {
+                continue;
+            }
+            
+            // Offsets are into the plain text, mapped back to the written line
+            var range = line.GetSourceRange(start, length);
+            context.Report(DiagnosticCode.UnknownWord, line, range, range.Start, word.ToString(), this);
+        }
+    }
+    
+    private bool IsKnown(ReadOnlySpan<char> word, ValidationContext context)
+    {
+        if (_spelling.Contains(word))
+        {
+            return true;
+        }
+        
+        // Possessive of a known word or name: Alan's
+        if (word.Length > 2 && (word[^1] is 's' or 'S') && word[^2] is '\'' or '’')
+        {
+            word = word[..^2];
+            if (_spelling.Contains(word))
+            {
+                return true;
+            }
+        }
+        
+        return context.IsKnownCharacter(word.ToString());
+    }
+    
+    // Letters with apostrophes inside (don't, rock'n'roll). Tokens with digits are read whole so
+    // they can be skipped, CJK text has no spaces between words and isn't checked
+    private static bool TryReadWord(ReadOnlySpan<char> text, ref int position, out int start, out int length)
+    {
+        while (position < text.Length && !char.IsLetterOrDigit(text[position]))
+        {
+            position++;
+        }
+        
+        start = position;
+        while (position < text.Length &&
+               (char.IsLetterOrDigit(text[position]) ||
+                text[position] is '\'' or '’' && position + 1 < text.Length && char.IsLetter(text[position + 1]) && position > start))
+        {
+            position++;
+        }
+        
+        length = position - start;
+        return length > 0;
+    }
+    
+    // Single letters, numbers, acronyms (NPC) and CJK are left alone
+    private static bool IsChecked(ReadOnlySpan<char> word)
+    {
+        if (word.Length < 2 || word.Length > SpellChecker.MaxWordLength)
+        {
+            return false;
+        }
+        
+        var hasLower = false;
+        foreach (var c in word)
+        {
+            if (char.IsDigit(c) || c >= '\u2E80')
+            {
+                return false;
+            }
+            hasLower |= char.IsLower(c);
+        }
+        return hasLower;
+    }
+    
+    // 'Teh', did you mean 'The', 'Tea'? Suggestions are written like the word
+    public string Format(string word)
+    {
+        var suggestions = _spelling.Suggest(word);
+        if (suggestions.Count == 0)
+        {
+            return $"'{word}'";
+        }
+        
+        var capitalize = char.IsUpper(word[0]);
+        for (var i = 0; i < suggestions.Count; i++)
+        {
+            var suggestion = suggestions[i];
+            if (capitalize && char.IsLower(suggestion[0]))
+            {
+                suggestion = char.ToUpperInvariant(suggestion[0]) + suggestion[1..];
+            }
+            suggestions[i] = $"'{suggestion}'";
+        }
+        return $"'{word}', did you mean {string.Join(", ", suggestions)}?";
+    }
+}
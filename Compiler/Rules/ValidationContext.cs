@@ -0,0 +1,154 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using DialScript.Models;
+using DialScript.Output;
+using DialScript.Parsing;
+using DialScript.Schema;
+
+namespace DialScript.Compiler.Rules;
+
+// Per-file validation state shared by all rules, and the place where they report errors.
+// A compiler keeps one and resets it for every file
+public sealed class ValidationContext
+{
+    private readonly CompilerSettings _settings;
+    // Diagnostics with the same code and argument (= the same message) are collapsed
+    private readonly Dictionary<(DiagnosticCode Code, string? Argument), int> _collapsedErrors = new();
+    private int _errorCount;
+    
+    public ValidationContext(CompilerSettings settings)
+    {
+        _settings = settings;
+        Reset();
+    }
+    
+    public CompilerSettings Settings => _settings;
+    
+    public string FilePath { get; private set; } = string.Empty;
+    
+    public LineIndex LineIndex { get; private set; } = null!;
+    
+    public ParsedLine[] ParsedLines { get; private set; } = [];
+    
+    public List<CompileError> Errors { get; private set; } = [];
+    
+    // Index of the line being validated
+    public int Index { get; set; }
+    
+    // Scene state
+    public bool HasScene { get; set; }
+    public bool HasLevel { get; set; }
+    public bool HasLocation { get; set; }
+    public bool HasCharacters { get; set; }
+    public bool InDialog { get; set; }
+    public int CurrentScene { get; set; }
+    public HashSet<string> KnownCharacters { get; } = new();
+    
+    // Included files, shared read-only with every other file of the run
+    public List<IncludeFile> Includes { get; } = new();
+    
+    // Line metadata schema: --schema merged with the included ones
+    public MetadataSchema? Schema { get; set; }
+    
+    public bool HasIncludedCharacters => Includes.Exists(i => i.Characters.Count > 0);
+    
+    public bool IsKnownCharacter(string name)
+    {
+        return KnownCharacters.Contains(name) || Includes.Exists(i => i.Characters.Contains(name));
+    }
+    
+    // Line break offsets of the line being validated (TextLayoutRule), reused from line to line
+    public List<int> LineBreaks { get; } = new();
+    
+    public ParsedLine? Next => Index + 1 < ParsedLines.Length ? ParsedLines[Index + 1] : null;
+    
+    public void Reset(string filePath, LineIndex lineIndex, ParsedLine[] parsedLines, List<CompileError> errors)
+    {
+        Reset();
+        FilePath = filePath;
+        LineIndex = lineIndex;
+        ParsedLines = parsedLines;
+        Errors = errors;
+    }
+    
+    // Back to the state before the first line, without references to the last file
+    public void Reset()
+    {
+        FilePath = string.Empty;
+        LineIndex = null!;
+        ParsedLines = [];
+        Errors = [];
+        Index = 0;
+        
+        HasScene = false;
+        HasLevel = false;
+        HasLocation = false;
+        HasCharacters = false;
+        InDialog = false;
+        CurrentScene = 0;
+        KnownCharacters.Clear();
+        Includes.Clear();
+        Schema = _settings.Schema;
+        
+        _collapsedErrors.Clear();
+        _errorCount = 0;
+    }
+    
+    public bool IsErrorLimitReached => _settings.MaxErrors > 0 && _errorCount >= _settings.MaxErrors;
+    
+    public void Report(DiagnosticCode code, ParsedLine line, int errorPosition = -1)
+    {
+        Report(code, line, line.ContentRange, errorPosition);
+    }
+    
+    public void Report(DiagnosticCode code, ParsedLine line, ColumnRange range, int errorPosition = -1, 
+        string? argument = null, IArgumentFormatter? formatter = null)
+    {
+        if (!TryCollapse(code, argument))
+        {
+            var span = LineIndex.GetSpan(line.LineNumber, range);
+            Add(new CompileError(code, span, line.OriginalContent, errorPosition, argument, formatter: formatter));
+        }
+    }
+    
+    // File-level errors, reported at the end of the file
+    public void ReportAtEnd(DiagnosticCode code)
+    {
+        if (!TryCollapse(code, null))
+        {
+            var end = LineIndex.GetEnd();
+            Add(new CompileError(code, new SourceSpan(end, end)));
+        }
+    }
+    
+    private void Add(CompileError error)
+    {
+        Errors.Add(error);
+        
+        if (!_settings.Quiet && !_settings.CollapseErrors)
+        {
+            ConsoleOutput.PrintError(error);
+        }
+    }
+    
+    private bool TryCollapse(DiagnosticCode code, string? argument)
+    {
+        _errorCount++;
+        
+        if (!_settings.CollapseErrors)
+        {
+            return false;
+        }
+        
+        if (_collapsedErrors.TryGetValue((code, argument), out var index))
+        {
+            Errors[index] = Errors[index].WithCount(Errors[index].Count + 1);
+            return true;
+        }
+        
+        _collapsedErrors[(code, argument)] = Errors.Count;
+        return false;
+    }
+}
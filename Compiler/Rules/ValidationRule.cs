@@ -0,0 +1,21 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using DialScript.Models;
+
+namespace DialScript.Compiler.Rules;
+
+// A validation rule is only called for the line types it subscribes to. Rule instances
+// are shared between compilers (and threads), so per-file state belongs in ValidationContext
+public abstract class ValidationRule
+{
+    public abstract IReadOnlyList<LineType> LineTypes { get; }
+    
+    public abstract void Validate(ParsedLine line, ValidationContext context);
+    
+    // Called once after the last line of the file
+    public virtual void Finish(ValidationContext context)
+    {
+    }
+}
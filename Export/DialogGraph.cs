@@ -0,0 +1,108 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Text;
+using DialScript.Compiler;
+using DialScript.Models;
+using DialScript.Parsing;
+
+namespace DialScript.Export;
+
+// Dialog flow of a script (--emit graph): scene -> dialog blocks -> lines in order, and
+// '{Choices: A, B}' -> '{Choice: A}' edges between branches. Lines are walked once and only
+// the pending choice options are remembered
+public static class DialogGraph
+{
+    // Writes <script>.dot or <script>.graphml next to the script
+    public static void Write(CompileResult result, GraphFormat format)
+    {
+        if (result.LineIndex == null)
+        {
+            return;
+        }
+
+        var path = Path.ChangeExtension(result.FilePath, GraphWriter.GetExtension(format));
+        using var output = new StreamWriter(path, append: false, new UTF8Encoding(false));
+        Write(result.ParsedLines, format, output, Path.GetFileNameWithoutExtension(result.FilePath));
+    }
+
+    public static void Write(ReadOnlySpan<ParsedLine> lines, GraphFormat format, TextWriter output, string name)
+    {
+        using var writer = GraphWriter.Create(format, output, name);
+
+        string? scene = null;
+        string? previous = null;
+        var choices = new Dictionary<string, string>(StringComparer.Ordinal);
+
+        foreach (var line in lines)
+        {
+            switch (line.Type)
+            {
+                case LineType.Scene:
+                    scene = $"s{line.LineNumber}";
+                    writer.WriteNode(scene, $"Scene {line.Number}", GraphElementKind.Scene);
+                    previous = null;
+                    choices.Clear();
+                    break;
+
+                case LineType.DialogHeader:
+                    var block = $"d{line.LineNumber}";
+                    writer.WriteNode(block, $"Dialog {line.Number}", GraphElementKind.Dialog);
+                    if (scene != null)
+                    {
+                        writer.WriteEdge(scene, block, null, GraphElementKind.Contains);
+                    }
+                    previous = block;
+                    break;
+
+                // Stray lines outside a dialog block are left out
+                case LineType.Dialog when previous != null:
+                    var id = $"l{line.LineNumber}";
+                    writer.WriteNode(id, $"{line.NameSpan}: {line.TextSpan}", GraphElementKind.Line);
+
+                    GetChoices(line, out var choice, out var options);
+                    if (choice != null && choices.TryGetValue(choice, out var source))
+                    {
+                        writer.WriteEdge(source, id, choice, GraphElementKind.Choice);
+                    }
+                    else
+                    {
+                        writer.WriteEdge(previous, id, null, GraphElementKind.Next);
+                    }
+
+                    if (options != null)
+                    {
+                        foreach (var option in options.Split(',', StringSplitOptions.TrimEntries | StringSplitOptions.RemoveEmptyEntries))
+                        {
+                            choices[option] = id;
+                        }
+                    }
+                    previous = id;
+                    break;
+            }
+        }
+    }
+
+    private static void GetChoices(ParsedLine line, out string? choice, out string? options)
+    {
+        choice = null;
+        options = null;
+        if (!line.HasMetadata)
+        {
+            return;
+        }
+
+        foreach (var entry in new MetadataParser(line.MetadataSpan))
+        {
+            if (entry.Key.Equals("Choice", StringComparison.OrdinalIgnoreCase))
+            {
+                choice = entry.Value.ToString();
+            }
+            else if (entry.Key.Equals("Choices", StringComparison.OrdinalIgnoreCase))
+            {
+                options = entry.Value.ToString();
+            }
+        }
+    }
+}
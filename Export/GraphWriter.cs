@@ -0,0 +1,204 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Text;
+using System.Xml;
+
+namespace DialScript.Export;
+
+public enum GraphFormat
+{
+    Dot,                         // Graphviz
+    GraphMl                      // GraphML (yEd, Gephi, ...)
+}
+
+public enum GraphElementKind
+{
+    Scene,                       // [Scene.N]
+    Dialog,                      // [Dialog.N]
+    Line,                        // Name: Text
+    Contains,                    // Scene -> dialog block
+    Next,                        // Line -> following line
+    Choice                       // Choices line -> Choice line
+}
+
+// Writes nodes and edges straight to the output as they come, nothing is kept in memory,
+// so the size of a graph is only limited by the disk
+public abstract class GraphWriter : IDisposable
+{
+    public static GraphWriter Create(GraphFormat format, TextWriter output, string name)
+    {
+        return format switch
+        {
+            GraphFormat.GraphMl => new GraphMlWriter(output, name),
+            _ => new DotGraphWriter(output, name)
+        };
+    }
+
+    public static string GetExtension(GraphFormat format) => format == GraphFormat.GraphMl ? ".graphml" : ".dot";
+
+    public abstract void WriteNode(string id, string label, GraphElementKind kind);
+
+    public abstract void WriteEdge(string from, string to, string? label, GraphElementKind kind);
+
+    // Closes the graph, the output itself stays open
+    public abstract void Dispose();
+}
+
+public sealed class DotGraphWriter : GraphWriter
+{
+    private readonly TextWriter _output;
+
+    public DotGraphWriter(TextWriter output, string name)
+    {
+        _output = output;
+        _output.WriteLine($"digraph {Quote(name)} {{");
+        _output.WriteLine("  node [shape=box];");
+    }
+
+    public override void WriteNode(string id, string label, GraphElementKind kind)
+    {
+        var shape = kind switch
+        {
+            GraphElementKind.Scene => ", shape=doubleoctagon",
+            GraphElementKind.Dialog => ", shape=ellipse",
+            _ => ""
+        };
+        _output.WriteLine($"  {Quote(id)} [label={Quote(label)}{shape}];");
+    }
+
+    public override void WriteEdge(string from, string to, string? label, GraphElementKind kind)
+    {
+        var attributes = kind == GraphElementKind.Contains ? " [style=dashed]"
+            : label != null ? $" [label={Quote(label)}]"
+            : "";
+        _output.WriteLine($"  {Quote(from)} -> {Quote(to)}{attributes};");
+    }
+
+    public override void Dispose()
+    {
+        _output.WriteLine("}");
+        _output.Flush();
+    }
+
+    private static string Quote(string value)
+    {
+        var quoted = new StringBuilder(value.Length + 2).Append('"');
+        foreach (var c in value)
+        {
+            if (c is '"' or '\\')
+            {
+                quoted.Append('\\');
+            }
+            quoted.Append(c);
+        }
+        return quoted.Append('"').ToString();
+    }
+}
+
+public sealed class GraphMlWriter : GraphWriter
+{
+    private readonly XmlWriter _xml;
+    private int _edgeCount;
+
+    public GraphMlWriter(TextWriter output, string name)
+    {
+        _xml = XmlWriter.Create(output, new XmlWriterSettings { Indent = true, CloseOutput = false });
+        _xml.WriteStartDocument();
+        _xml.WriteStartElement("graphml", "http://graphml.graphdrawing.org/xmlns");
+        WriteKey("label", "all");
+        WriteKey("kind", "all");
+        _xml.WriteStartElement("graph");
+        _xml.WriteAttributeString("id", Sanitize(name));
+        _xml.WriteAttributeString("edgedefault", "directed");
+    }
+
+    public override void WriteNode(string id, string label, GraphElementKind kind)
+    {
+        _xml.WriteStartElement("node");
+        _xml.WriteAttributeString("id", Sanitize(id));
+        WriteData("label", label);
+        WriteData("kind", kind);
+        _xml.WriteEndElement();
+    }
+
+    public override void WriteEdge(string from, string to, string? label, GraphElementKind kind)
+    {
+        _xml.WriteStartElement("edge");
+        _xml.WriteAttributeString("id", $"e{_edgeCount++}");
+        _xml.WriteAttributeString("source", Sanitize(from));
+        _xml.WriteAttributeString("target", Sanitize(to));
+        if (label != null)
+        {
+            WriteData("label", label);
+        }
+        WriteData("kind", kind);
+        _xml.WriteEndElement();
+    }
+
+    public override void Dispose()
+    {
+        _xml.WriteEndDocument();
+        _xml.Dispose();
+    }
+
+    private void WriteKey(string id, string scope)
+    {
+        _xml.WriteStartElement("key");
+        _xml.WriteAttributeString("id", id);
+        _xml.WriteAttributeString("for", scope);
+        _xml.WriteAttributeString("attr.name", id);
+        _xml.WriteAttributeString("attr.type", "string");
+        _xml.WriteEndElement();
+    }
+
+    private void WriteData(string key, string value)
+    {
+        _xml.WriteStartElement("data");
+        _xml.WriteAttributeString("key", key);
+        _xml.WriteString(Sanitize(value));
+        _xml.WriteEndElement();
+    }
+
+    private void WriteData(string key, GraphElementKind kind)
+    {
+        WriteData(key, kind.ToString().ToLowerInvariant());
+    }
+
+    // XML can't hold control characters (not even as &#1;) or lone surrogates, and XmlWriter
+    // throws on them, so they become U+FFFD
+    private static string Sanitize(string value)
+    {
+        var invalid = IndexOfInvalidChar(value, 0);
+        if (invalid < 0)
+        {
+            return value;
+        }
+
+        var sanitized = new StringBuilder(value);
+        for (; invalid >= 0; invalid = IndexOfInvalidChar(value, invalid + 1))
+        {
+            sanitized[invalid] = '\uFFFD';
+        }
+        return sanitized.ToString();
+    }
+
+    private static int IndexOfInvalidChar(string value, int start)
+    {
+        for (var i = start; i < value.Length; i++)
+        {
+            if (XmlConvert.IsXmlChar(value[i]))
+            {
+                continue;
+            }
+            if (i + 1 < value.Length && XmlConvert.IsXmlSurrogatePair(value[i + 1], value[i]))
+            {
+                i++;
+                continue;
+            }
+            return i;
+        }
+        return -1;
+    }
+}
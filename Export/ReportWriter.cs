@@ -0,0 +1,401 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using DialScript.Models;
+
+namespace DialScript.Export;
+
+// One element of a screenplay report. Text arguments are spans of the source lines and are
+// escaped piece by piece straight into the output, nothing is buffered per document
+public abstract class ReportWriter : IDisposable
+{
+    protected ReportWriter(TextWriter output)
+    {
+        Output = output;
+    }
+
+    protected TextWriter Output { get; }
+
+    public abstract void WriteTitle(string title);
+
+    public abstract void WriteScene(int number);
+
+    public abstract void WriteDialog(int number);
+
+    // Level, Location, Characters, Include
+    public abstract void WriteSceneInfo(string key, ReadOnlySpan<char> value);
+
+    public abstract void WriteComment(ReadOnlySpan<char> text);
+
+    public abstract void WriteLine(ReadOnlySpan<char> speaker, ReadOnlySpan<char> text, in DialogMetadata metadata);
+
+    // Line that didn't parse, shown as written
+    public abstract void WriteInvalidLine(int lineNumber, string content);
+
+    public abstract void WriteDiagnostic(in CompileError error);
+
+    public abstract void WriteFooter(int totalLines, int errorCount);
+
+    public abstract void Dispose();
+}
+
+// What the report shows of '{Key: Value}' line metadata
+public readonly ref struct DialogMetadata
+{
+    public ReadOnlySpan<char> Emotion { get; init; }
+
+    // Branch this line belongs to
+    public ReadOnlySpan<char> Choice { get; init; }
+
+    // Branches offered by this line
+    public ReadOnlySpan<char> Choices { get; init; }
+
+    // Whole metadata, shown as is when it has keys besides the ones above
+    public ReadOnlySpan<char> Other { get; init; }
+}
+
+// HTML page, colored like the console output: scenes cyan, dialog blocks magenta,
+// speakers bold, metadata yellow, errors red, hints gray
+public sealed class HtmlReportWriter : ReportWriter
+{
+    private const string Style = """
+        body { font-family: "Courier Prime", "Courier New", monospace; max-width: 46em; margin: 2em auto; color: #222; }
+        .scene { color: #0aa; font-weight: bold; }
+        .dialog { color: #a0a; font-weight: bold; }
+        .info { margin: 0; color: #555; }
+        .info b { color: #0aa; font-weight: normal; }
+        .comment { color: #999; font-style: italic; margin: 0.5em 0; }
+        .line { margin: 1em 0 1em 10em; }
+        .speaker { font-weight: bold; margin-left: 8em; }
+        .emotion, .metadata, .choices { color: #a80; }
+        .choice { color: #a80; font-weight: bold; }
+        .text { margin: 0.2em 0 0 0; }
+        .invalid { color: #c00; margin: 1em 0 0 0; }
+        .error { color: #c00; font-weight: bold; margin: 0.2em 0 0.2em 1em; }
+        .error .id, .hint { color: #888; font-weight: normal; }
+        .footer { color: #0a0; font-weight: bold; margin-top: 2em; }
+        .footer.broken { color: #c00; }
+        """;
+
+    public HtmlReportWriter(TextWriter output) : base(output)
+    {
+    }
+
+    public override void WriteTitle(string title)
+    {
+        Output.Write("<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n<title>");
+        Escape(title);
+        Output.Write("</title>\n<style>\n");
+        Output.Write(Style);
+        Output.Write("\n</style>\n</head>\n<body>\n<h1>");
+        Escape(title);
+        Output.Write("</h1>\n");
+    }
+
+    public override void WriteScene(int number)
+    {
+        Output.Write($"<h2 class=\"scene\">◉ Scene {number}</h2>\n");
+    }
+
+    public override void WriteDialog(int number)
+    {
+        Output.Write($"<h3 class=\"dialog\">◆ Dialog {number}</h3>\n");
+    }
+
+    public override void WriteSceneInfo(string key, ReadOnlySpan<char> value)
+    {
+        Output.Write($"<p class=\"info\"><b>{key}:</b> ");
+        Escape(value);
+        Output.Write("</p>\n");
+    }
+
+    public override void WriteComment(ReadOnlySpan<char> text)
+    {
+        Output.Write("<p class=\"comment\">");
+        Escape(text);
+        Output.Write("</p>\n");
+    }
+
+    public override void WriteLine(ReadOnlySpan<char> speaker, ReadOnlySpan<char> text, in DialogMetadata metadata)
+    {
+        Output.Write("<div class=\"line\">\n");
+        if (!metadata.Choice.IsEmpty)
+        {
+            Output.Write("<div class=\"choice\">↳ ");
+            Escape(metadata.Choice);
+            Output.Write("</div>\n");
+        }
+
+        Output.Write("<div class=\"speaker\">");
+        Escape(speaker);
+        if (!metadata.Emotion.IsEmpty)
+        {
+            Output.Write(" <span class=\"emotion\">(");
+            Escape(metadata.Emotion);
+            Output.Write(")</span>");
+        }
+        Output.Write("</div>\n<p class=\"text\">");
+        Escape(text);
+        if (!metadata.Other.IsEmpty)
+        {
+            Output.Write(" <span class=\"metadata\">");
+            Escape(metadata.Other);
+            Output.Write("</span>");
+        }
+        Output.Write("</p>\n");
+
+        if (!metadata.Choices.IsEmpty)
+        {
+            Output.Write("<div class=\"choices\">Choices: ");
+            Escape(metadata.Choices);
+            Output.Write("</div>\n");
+        }
+        Output.Write("</div>\n");
+    }
+
+    public override void WriteInvalidLine(int lineNumber, string content)
+    {
+        Output.Write($"<pre class=\"invalid\">{lineNumber,4} │ ");
+        Escape(content);
+        Output.Write("</pre>\n");
+    }
+
+    public override void WriteDiagnostic(in CompileError error)
+    {
+        Output.Write("<div class=\"error\">✗ ");
+        Escape(error.Message);
+        if (error.Count > 1)
+        {
+            Output.Write($" ×{error.Count}");
+        }
+        Output.Write($" <span class=\"id\">[{error.Id}]</span>");
+        if (error.Hint is { } hint)
+        {
+            Output.Write("<div class=\"hint\">Hint: ");
+            Escape(hint);
+            Output.Write("</div>");
+        }
+        Output.Write("</div>\n");
+    }
+
+    public override void WriteFooter(int totalLines, int errorCount)
+    {
+        Output.Write(errorCount == 0
+            ? $"<p class=\"footer\">Parsing completed: {totalLines} lines processed</p>\n"
+            : $"<p class=\"footer broken\">Parsing broken: {totalLines} lines processed, {errorCount} error(s)</p>\n");
+    }
+
+    public override void Dispose()
+    {
+        Output.Write("</body>\n</html>\n");
+        Output.Flush();
+    }
+
+    // Writes the runs between special characters as slices, no escaped copy is built
+    private void Escape(ReadOnlySpan<char> text)
+    {
+        while (!text.IsEmpty)
+        {
+            var special = text.IndexOfAny("<>&\"");
+            if (special < 0)
+            {
+                Output.Write(text);
+                return;
+            }
+
+            Output.Write(text[..special]);
+            Output.Write(text[special] switch
+            {
+                '<' => "&lt;",
+                '>' => "&gt;",
+                '&' => "&amp;",
+                _ => "&quot;"
+            });
+            text = text[(special + 1)..];
+        }
+    }
+}
+
+// Markdown for review tools that render it (Git hosting, wikis)
+public sealed class MarkdownReportWriter : ReportWriter
+{
+    public MarkdownReportWriter(TextWriter output) : base(output)
+    {
+    }
+
+    public override void WriteTitle(string title)
+    {
+        Output.Write("# ");
+        Escape(title);
+        Output.Write("\n\n");
+    }
+
+    public override void WriteScene(int number)
+    {
+        Output.Write($"\n## ◉ Scene {number}\n\n");
+    }
+
+    public override void WriteDialog(int number)
+    {
+        Output.Write($"\n### ◆ Dialog {number}\n\n");
+    }
+
+    public override void WriteSceneInfo(string key, ReadOnlySpan<char> value)
+    {
+        Output.Write($"**{key}:** ");
+        Escape(value);
+        Output.Write("  \n");
+    }
+
+    public override void WriteComment(ReadOnlySpan<char> text)
+    {
+        Output.Write("\n*");
+        Escape(text);
+        Output.Write("*\n\n");
+    }
+
+    public override void WriteLine(ReadOnlySpan<char> speaker, ReadOnlySpan<char> text, in DialogMetadata metadata)
+    {
+        if (!metadata.Choice.IsEmpty)
+        {
+            Output.Write("↳ *");
+            Escape(metadata.Choice);
+            Output.Write("*  \n");
+        }
+
+        Output.Write("**");
+        Escape(speaker);
+        Output.Write("**");
+        if (!metadata.Emotion.IsEmpty)
+        {
+            Output.Write(" (");
+            Escape(metadata.Emotion);
+            Output.Write(")");
+        }
+        Output.Write(": ");
+        Escape(text);
+        if (!metadata.Other.IsEmpty)
+        {
+            Output.Write(' ');
+            WriteCode(metadata.Other);
+        }
+        Output.Write("\n\n");
+
+        if (!metadata.Choices.IsEmpty)
+        {
+            Output.Write("> Choices: ");
+            Escape(metadata.Choices);
+            Output.Write("\n\n");
+        }
+    }
+
+    public override void WriteInvalidLine(int lineNumber, string content)
+    {
+        // A fence longer than any backtick run of the line, so the line can't close it
+        var fence = Math.Max(3, LongestBacktickRun(content) + 1);
+        WriteBackticks(fence);
+        Output.Write($"\n{lineNumber,4} │ ");
+        Output.Write(content);
+        Output.Write('\n');
+        WriteBackticks(fence);
+        Output.Write("\n\n");
+    }
+
+    public override void WriteDiagnostic(in CompileError error)
+    {
+        Output.Write("> ✗ **");
+        Escape(error.Message);
+        Output.Write("**");
+        if (error.Count > 1)
+        {
+            Output.Write($" ×{error.Count}");
+        }
+        Output.Write($" `{error.Id}`");
+        if (error.Hint is { } hint)
+        {
+            Output.Write(" — ");
+            Escape(hint);
+        }
+        Output.Write("\n\n");
+    }
+
+    public override void WriteFooter(int totalLines, int errorCount)
+    {
+        Output.Write(errorCount == 0
+            ? $"---\n\n**Parsing completed:** {totalLines} lines processed\n"
+            : $"---\n\n**Parsing broken:** {totalLines} lines processed, {errorCount} error(s)\n");
+    }
+
+    public override void Dispose()
+    {
+        Output.Flush();
+    }
+
+    // Code span delimited by more backticks than the text has in a row. A space pads text that
+    // starts or ends with a backtick (Markdown strips it again)
+    private void WriteCode(ReadOnlySpan<char> text)
+    {
+        var delimiter = LongestBacktickRun(text) + 1;
+        var pad = text[0] == '`' || text[^1] == '`';
+        WriteBackticks(delimiter);
+        if (pad)
+        {
+            Output.Write(' ');
+        }
+        Output.Write(text);
+        if (pad)
+        {
+            Output.Write(' ');
+        }
+        WriteBackticks(delimiter);
+    }
+
+    private void WriteBackticks(int count)
+    {
+        for (var i = 0; i < count; i++)
+        {
+            Output.Write('`');
+        }
+    }
+
+    private static int LongestBacktickRun(ReadOnlySpan<char> text)
+    {
+        var longest = 0;
+        while (true)
+        {
+            var start = text.IndexOf('`');
+            if (start < 0)
+            {
+                return longest;
+            }
+            text = text[start..];
+            var run = text.IndexOfAnyExcept('`');
+            if (run < 0)
+            {
+                return Math.Max(longest, text.Length);
+            }
+            longest = Math.Max(longest, run);
+            text = text[run..];
+        }
+    }
+
+    // Backslash before characters Markdown would treat as formatting
+    private void Escape(ReadOnlySpan<char> text)
+    {
+        while (!text.IsEmpty)
+        {
+            var special = text.IndexOfAny("\\`*_[]<>#|");
+            if (special < 0)
+            {
+                Output.Write(text);
+                return;
+            }
+
+            Output.Write(text[..special]);
+            Output.Write('\\');
+            Output.Write(text[special]);
+            text = text[(special + 1)..];
+        }
+    }
+}
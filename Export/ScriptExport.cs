@@ -0,0 +1,64 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using DialScript.Compiler;
+using DialScript.Models;
+
+namespace DialScript.Export;
+
+[Flags]
+public enum EmitTarget
+{
+    None = 0,
+    Graph = 1,                   // Dialog flow graph (--emit graph)
+    Html = 2,                    // Screenplay report (--emit html)
+    Markdown = 4,                // Screenplay report (--emit md)
+    Text = 8                     // Plain dialog text and markup runs (--emit text)
+}
+
+// Extra artifacts written next to a compiled script (--emit). Runs on the thread that
+// compiled the file, so a directory build exports in parallel
+public static class ScriptExport
+{
+    private static readonly EmitTarget[] Targets = [EmitTarget.Graph, EmitTarget.Html, EmitTarget.Markdown, EmitTarget.Text];
+    
+    // An artifact that can't be written is reported as an error of the script and the others
+    // are still written. Returns the number of failed artifacts
+    public static int Write(CompileResult result, CompilerSettings settings)
+    {
+        var failed = 0;
+        foreach (var target in Targets)
+        {
+            if (!settings.Emit.HasFlag(target))
+            {
+                continue;
+            }
+            
+            try
+            {
+                switch (target)
+                {
+                    case EmitTarget.Graph:
+                        DialogGraph.Write(result, settings.GraphFormat);
+                        break;
+                    case EmitTarget.Html:
+                        ScriptReport.Write(result, ReportFormat.Html);
+                        break;
+                    case EmitTarget.Markdown:
+                        ScriptReport.Write(result, ReportFormat.Markdown);
+                        break;
+                    case EmitTarget.Text:
+                        TextSidecar.Write(result, settings.Layout);
+                        break;
+                }
+            }
+            catch (Exception e) when (e is IOException or UnauthorizedAccessException)
+            {
+                result.Errors.Add(new CompileError(DiagnosticCode.ExportFailed, default, argument: e.Message));
+                failed++;
+            }
+        }
+        return failed;
+    }
+}
@@ -0,0 +1,135 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Text;
+using DialScript.Compiler;
+using DialScript.Models;
+using DialScript.Parsing;
+
+namespace DialScript.Export;
+
+public enum ReportFormat
+{
+    Html,
+    Markdown
+}
+
+// Screenplay view of a compiled script (--emit html, --emit md) with its diagnostics under
+// the lines they belong to. Written line by line while walking the compile result
+public static class ScriptReport
+{
+    private const int BufferSize = 64 * 1024;
+
+    // Writes <script>.html or <script>.md next to the script
+    public static void Write(CompileResult result, ReportFormat format)
+    {
+        if (result.LineIndex == null)
+        {
+            return;
+        }
+
+        var path = Path.ChangeExtension(result.FilePath, format == ReportFormat.Html ? ".html" : ".md");
+        using var output = new StreamWriter(path, new UTF8Encoding(false),
+            new FileStreamOptions { Mode = FileMode.Create, Access = FileAccess.Write, BufferSize = BufferSize });
+        using ReportWriter writer = format == ReportFormat.Html
+            ? new HtmlReportWriter(output)
+            : new MarkdownReportWriter(output);
+        Write(result, writer);
+    }
+
+    public static void Write(CompileResult result, ReportWriter writer)
+    {
+        writer.WriteTitle(Path.GetFileName(result.FilePath));
+
+        // Errors are in line order, except file-level ones which come last
+        var errors = result.Errors;
+        var next = 0;
+
+        foreach (var line in result.ParsedLines)
+        {
+            switch (line.Type)
+            {
+                case LineType.Empty:
+                    break;
+
+                case LineType.Comment:
+                    writer.WriteComment(line.Value);
+                    break;
+
+                case LineType.Scene:
+                    writer.WriteScene(line.Number);
+                    break;
+
+                case LineType.DialogHeader:
+                    writer.WriteDialog(line.Number);
+                    break;
+
+                case LineType.Level:
+                case LineType.Location:
+                case LineType.Characters:
+                case LineType.Include:
+                    writer.WriteSceneInfo(line.Type.ToString(), line.Value);
+                    break;
+
+                case LineType.Dialog:
+                    writer.WriteLine(line.NameSpan, line.TextSpan, GetMetadata(line));
+                    break;
+
+                default:
+                    writer.WriteInvalidLine(line.LineNumber, line.OriginalContent);
+                    break;
+            }
+
+            while (next < errors.Count && errors[next].LineNumber <= line.LineNumber)
+            {
+                writer.WriteDiagnostic(errors[next++]);
+            }
+        }
+
+        while (next < errors.Count)
+        {
+            writer.WriteDiagnostic(errors[next++]);
+        }
+
+        writer.WriteFooter(result.TotalLines, result.ErrorCount);
+    }
+
+    private static DialogMetadata GetMetadata(ParsedLine line)
+    {
+        if (!line.HasMetadata)
+        {
+            return default;
+        }
+
+        ReadOnlySpan<char> emotion = default, choice = default, choices = default;
+        var other = false;
+        foreach (var entry in new MetadataParser(line.MetadataSpan))
+        {
+            if (entry.Key.Equals("Emotion", StringComparison.OrdinalIgnoreCase))
+            {
+                emotion = entry.Value;
+            }
+            else if (entry.Key.Equals("Choice", StringComparison.OrdinalIgnoreCase))
+            {
+                choice = entry.Value;
+            }
+            else if (entry.Key.Equals("Choices", StringComparison.OrdinalIgnoreCase))
+            {
+                choices = entry.Value;
+            }
+            else
+            {
+                other = true;
+            }
+        }
+
+        return new DialogMetadata
+        {
+            Emotion = emotion,
+            Choice = choice,
+            Choices = choices,
+            Other = other ? line.MetadataSpan : default
+        };
+    }
+}
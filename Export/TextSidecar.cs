@@ -0,0 +1,204 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Globalization;
+using System.Text;
+using System.Text.Encodings.Web;
+using System.Text.Json;
+using DialScript.Compiler;
+using DialScript.Models;
+using DialScript.Parsing;
+using DialScript.Schema;
+
+namespace DialScript.Export;
+
+// Render data of the dialog text for the game (--emit text): <script>.text.json with the
+// plain text of every dialog line and its markup runs as [offset, length, style, pauseMs].
+// Style ids are numbered per file in order of first use, lines without runs are one default run.
+// Lines are keyed by scene, dialog and index in the dialog block. With --layout every line
+// also gets the offsets of its line and page breaks in the text box
+public static class TextSidecar
+{
+    public static void Write(CompileResult result, TextLayout? layout)
+    {
+        if (result.LineIndex == null)
+        {
+            return;
+        }
+
+        var path = Path.ChangeExtension(result.FilePath, ".text.json");
+        using var stream = File.Create(path);
+        // Text is written as is instead of \u escapes, the file is not embedded in HTML. Characters
+        // outside the BMP (emoji) are the exception: System.Text.Json always writes them as
+        // surrogate pair escapes ("\uD83D\uDE00"), which JSON readers decode to the same text
+        using var json = new Utf8JsonWriter(stream, new JsonWriterOptions
+        {
+            Indented = true,
+            Encoder = JavaScriptEncoder.UnsafeRelaxedJsonEscaping
+        });
+        Write(result, layout, json);
+    }
+
+    public static void Write(CompileResult result, TextLayout? layout, Utf8JsonWriter json)
+    {
+        var breaks = layout != null ? new List<int>() : null;
+        // Styles of all lines, numbered in the order they first appear in this file
+        var styleIds = new Dictionary<TextStyle, int> { [TextStyle.Default] = 0 };
+        var styles = new List<TextStyle> { TextStyle.Default };
+
+        json.WriteStartObject();
+        json.WriteString("file", Path.GetFileName(result.FilePath));
+        json.WriteStartArray("lines");
+
+        int scene = 0, dialog = 0, index = 0;
+        foreach (var line in result.ParsedLines)
+        {
+            switch (line.Type)
+            {
+                case LineType.Scene:
+                    scene = line.Number;
+                    dialog = 0;
+                    index = 0;
+                    continue;
+
+                case LineType.DialogHeader:
+                    dialog = line.Number;
+                    index = 0;
+                    continue;
+
+                case not LineType.Dialog:
+                    continue;
+            }
+
+            json.WriteStartObject();
+            json.WriteNumber("scene", scene);
+            json.WriteNumber("dialog", dialog);
+            json.WriteNumber("index", index++);
+            json.WriteNumber("line", line.LineNumber);
+            json.WriteString("speaker", line.NameSpan);
+            json.WriteString("text", line.TextSpan);
+            WriteGraphemes(line.TextSpan, json);
+            if (layout != null)
+            {
+                WriteBreaks(line.TextSpan, layout, breaks!, json);
+            }
+            if (line.HasMarkup)
+            {
+                json.WriteStartArray("runs");
+                foreach (var run in line.Runs)
+                {
+                    var style = line.Styles[run.StyleId];
+                    if (!styleIds.TryGetValue(style, out var styleId))
+                    {
+                        styleId = styleIds[style] = styles.Count;
+                        styles.Add(style);
+                    }
+
+                    json.WriteStartArray();
+                    json.WriteNumberValue(run.Offset);
+                    json.WriteNumberValue(run.Length);
+                    json.WriteNumberValue(styleId);
+                    json.WriteNumberValue(run.PauseMs);
+                    json.WriteEndArray();
+                }
+                json.WriteEndArray();
+            }
+            json.WriteEndObject();
+        }
+
+        json.WriteEndArray();
+
+        json.WriteStartArray("styles");
+        foreach (var style in styles)
+        {
+            json.WriteStartObject();
+            if (style.Emphasis.HasFlag(TextEmphasis.Bold))
+            {
+                json.WriteBoolean("bold", true);
+            }
+            if (style.Emphasis.HasFlag(TextEmphasis.Italic))
+            {
+                json.WriteBoolean("italic", true);
+            }
+            if (style.Color != null)
+            {
+                json.WriteString("color", style.Color);
+            }
+            if (style.Speed != 1f)
+            {
+                json.WriteNumber("speed", style.Speed);
+            }
+            json.WriteEndObject();
+        }
+        json.WriteEndArray();
+
+        json.WriteEndObject();
+    }
+
+    // Offsets where the text box starts a new line and a new page, the first line and page
+    // start at 0 and are left out
+    private static void WriteBreaks(ReadOnlySpan<char> text, TextLayout layout, List<int> breaks, Utf8JsonWriter json)
+    {
+        breaks.Clear();
+        layout.Break(text, breaks, out _);
+        if (breaks.Count == 0)
+        {
+            return;
+        }
+
+        json.WriteStartArray("breaks");
+        foreach (var offset in breaks)
+        {
+            json.WriteNumberValue(offset);
+        }
+        json.WriteEndArray();
+
+        if (breaks.Count >= layout.LinesPerPage)
+        {
+            json.WriteStartArray("pages");
+            for (var line = layout.LinesPerPage; line <= breaks.Count; line += layout.LinesPerPage)
+            {
+                json.WriteNumberValue(breaks[line - 1]);
+            }
+            json.WriteEndArray();
+        }
+    }
+
+    // Extended grapheme clusters as their lengths in UTF-16 units, so the renderer steps by
+    // user-perceived character without segmenting at display time. Left out when every
+    // character is a cluster of its own, which is the case for all ASCII text
+    private static void WriteGraphemes(ReadOnlySpan<char> text, Utf8JsonWriter json)
+    {
+        if (Ascii.IsValid(text))
+        {
+            return;
+        }
+
+        var single = true;
+        for (var rest = text; !rest.IsEmpty;)
+        {
+            var length = StringInfo.GetNextTextElementLength(rest);
+            if (length > 1)
+            {
+                single = false;
+                break;
+            }
+            rest = rest[length..];
+        }
+
+        if (single)
+        {
+            return;
+        }
+
+        json.WriteStartArray("graphemes");
+        for (var rest = text; !rest.IsEmpty;)
+        {
+            var length = StringInfo.GetNextTextElementLength(rest);
+            json.WriteNumberValue(length);
+            rest = rest[length..];
+        }
+        json.WriteEndArray();
+    }
+}
@@ -0,0 +1,151 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Text.RegularExpressions;
+using DialScript.Models;
+
+namespace DialScript.Formatting;
+
+// Machine-applicable fixes for parser errors that have exactly one obvious fix
+public static partial class DiagnosticFixes
+{
+    [GeneratedRegex(@"^\[\s*([a-z]+)\s*\.?\s*(\d+)\s*\]$", RegexOptions.IgnoreCase)]
+    private static partial Regex TypoHeaderPattern();
+    
+    // Returns the column range of the line to replace and the replacement text
+    public static bool TryCreate(ParsedLine parsed, out ColumnRange range, out string newText)
+    {
+        var line = parsed.OriginalContent;
+        range = default;
+        newText = string.Empty;
+        
+        switch (parsed.Type)
+        {
+            case LineType.ErrorLeadingSpace:
+                range = new ColumnRange(0, parsed.ContentRange.Start);
+                return range.Length > 0;
+                
+            case LineType.ErrorNoSpaceAfterColon:
+                var colon = line.IndexOf(':');
+                range = new ColumnRange(colon + 1, colon + 1);
+                newText = " ";
+                return colon >= 0;
+                
+            case LineType.ErrorExtraSpaceInHeader:
+                return TryFixHeader(parsed, null, out range, out newText);
+                
+            case LineType.ErrorTypoScene:
+                return TryFixHeader(parsed, "Scene", out range, out newText);
+                
+            case LineType.ErrorTypoDialog:
+                return TryFixHeader(parsed, "Dialog", out range, out newText);
+                
+            case LineType.ErrorTypoLevel:
+                return TryFixKey(parsed, "Level", out range, out newText);
+                
+            case LineType.ErrorTypoLocation:
+                return TryFixKey(parsed, "Location", out range, out newText);
+                
+            case LineType.ErrorTypoCharacters:
+                return TryFixKey(parsed, "Characters", out range, out newText);
+        }
+        
+        return false;
+    }
+    
+    // Applies a fix to the line text
+    public static string Apply(string line, ColumnRange range, string newText)
+    {
+        return string.Concat(line.AsSpan(0, range.Start), newText, line.AsSpan(range.End));
+    }
+    
+    // [Scen.1], [scene 1], [ Dialog . 2 ] → [Scene.1], [Scene.1], [Dialog.2]
+    private static bool TryFixHeader(ParsedLine parsed, string? keyword, out ColumnRange range, out string newText)
+    {
+        range = parsed.ContentRange;
+        newText = string.Empty;
+        
+        var match = TypoHeaderPattern().Match(parsed.OriginalContent[range.Start..range.End]);
+        if (!match.Success || !int.TryParse(match.Groups[2].ValueSpan, out var number) || number <= 0)
+        {
+            return false;
+        }
+        
+        var written = match.Groups[1].Value;
+        keyword ??= written.Equals("scene", StringComparison.OrdinalIgnoreCase) ? "Scene"
+            : written.Equals("dialog", StringComparison.OrdinalIgnoreCase) ? "Dialog"
+            : null;
+        
+        // Only obvious typos, [Chapter.1] is not a misspelled [Scene.1]
+        if (keyword == null || !IsCloseTo(written, keyword))
+        {
+            return false;
+        }
+        
+        newText = $"[{keyword}.{number}]";
+        return true;
+    }
+    
+    // Leve: 1, Level : 1 → Level: 1
+    private static bool TryFixKey(ParsedLine parsed, string key, out ColumnRange range, out string newText)
+    {
+        var line = parsed.OriginalContent;
+        var start = parsed.ContentRange.Start;
+        var colon = line.IndexOf(':', start);
+        range = default;
+        newText = string.Empty;
+        
+        if (colon < 0 || !IsCloseTo(line.AsSpan(start, colon - start).Trim(), key))
+        {
+            return false;
+        }
+        
+        // Replace the key, the colon and the whitespace after it
+        var valueStart = colon + 1;
+        while (valueStart < line.Length && char.IsWhiteSpace(line[valueStart]))
+        {
+            valueStart++;
+        }
+        if (valueStart >= parsed.ContentRange.End)
+        {
+            return false;
+        }
+        
+        range = new ColumnRange(start, valueStart);
+        newText = $"{key}: ";
+        return true;
+    }
+    
+    // Case-insensitive edit distance of at most 2
+    private static bool IsCloseTo(ReadOnlySpan<char> written, string expected)
+    {
+        if (Math.Abs(written.Length - expected.Length) > 2)
+        {
+            return false;
+        }
+        
+        Span<int> previous = stackalloc int[expected.Length + 1];
+        Span<int> current = stackalloc int[expected.Length + 1];
+        for (var j = 0; j <= expected.Length; j++)
+        {
+            previous[j] = j;
+        }
+        
+        for (var i = 1; i <= written.Length; i++)
+        {
+            current[0] = i;
+            for (var j = 1; j <= expected.Length; j++)
+            {
+                var cost = char.ToLowerInvariant(written[i - 1]) == char.ToLowerInvariant(expected[j - 1]) ? 0 : 1;
+                current[j] = Math.Min(Math.Min(current[j - 1] + 1, previous[j] + 1), previous[j - 1] + cost);
+            }
+            
+            var swap = previous;
+            previous = current;
+            current = swap;
+        }
+        
+        return previous[expected.Length] <= 2;
+    }
+}
@@ -0,0 +1,49 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Text;
+using System.Text.Unicode;
+using DialScript.Models;
+
+namespace DialScript.Formatting;
+
+public static class FixWriter
+{
+    // Applies all edits to the file in one rewrite. Edits use byte offsets of the file as it
+    // was compiled, so everything outside of them (line endings, BOM) stays untouched
+    public static void Apply(string path, IReadOnlyList<TextEdit> edits)
+    {
+        if (edits.Count == 0)
+        {
+            return;
+        }
+        
+        var sorted = edits.OrderBy(e => e.Span.Start.Offset).ToArray();
+        var bytes = File.ReadAllBytes(path);
+        
+        // The compiler only makes edits for UTF-8 files, this catches a file that changed since
+        if (!Utf8.IsValid(bytes))
+        {
+            return;
+        }
+        
+        using var output = new MemoryStream(bytes.Length + 64);
+        var position = 0;
+        foreach (var edit in sorted)
+        {
+            // Overlapping edits can't both be right, keep the first one
+            if (edit.Span.Start.Offset < position)
+            {
+                continue;
+            }
+            
+            output.Write(bytes, position, edit.Span.Start.Offset - position);
+            output.Write(Encoding.UTF8.GetBytes(edit.NewText));
+            position = edit.Span.End.Offset;
+        }
+        output.Write(bytes, position, bytes.Length - position);
+        
+        File.WriteAllBytes(path, output.ToArray());
+    }
+}
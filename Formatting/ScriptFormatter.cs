@@ -0,0 +1,235 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Text;
+using System.Text.RegularExpressions;
+using DialScript.Parsing;
+
+namespace DialScript.Formatting;
+
+public enum FormatResult
+{
+    Unchanged,
+    Formatted,
+    NotUtf8                      // Left alone, see ScriptFormatter.FormatFile
+}
+
+// Normalizes whitespace the way the compiler expects it: headers without spaces,
+// 'Key: Value' with one space after the colon, '{Key: Value}' metadata, '// comment'
+// and no leading spaces. Only whitespace (and keyword casing) is ever changed
+public static partial class ScriptFormatter
+{
+    [GeneratedRegex(@"^\[\s*(scene|dialog)\s*\.\s*(\d+)\s*\]$", RegexOptions.IgnoreCase)]
+    private static partial Regex HeaderPattern();
+    
+    [GeneratedRegex(@"^(level|location|characters|include)\s*:\s*(.*)$", RegexOptions.IgnoreCase)]
+    private static partial Regex MetadataPattern();
+    
+    public static string FormatLine(string line)
+    {
+        var trimmed = line.Trim();
+        
+        // Empty line
+        if (trimmed.Length == 0)
+        {
+            return string.Empty;
+        }
+        
+        // Comment
+        if (trimmed.StartsWith("//"))
+        {
+            var comment = trimmed[2..].TrimStart();
+            return comment.Length > 0 ? $"// {comment}" : "//";
+        }
+        
+        // Header
+        if (trimmed.StartsWith('['))
+        {
+            var header = HeaderPattern().Match(trimmed);
+            if (!header.Success)
+            {
+                return trimmed;
+            }
+            
+            var keyword = header.Groups[1].Value.Equals("scene", StringComparison.OrdinalIgnoreCase) ? "Scene" : "Dialog";
+            return $"[{keyword}.{header.Groups[2].Value}]";
+        }
+        
+        // Scene metadata
+        var metadata = MetadataPattern().Match(trimmed);
+        if (metadata.Success && metadata.Groups[2].Length > 0)
+        {
+            var key = metadata.Groups[1].Value.ToLowerInvariant() switch
+            {
+                "level" => "Level",
+                "location" => "Location",
+                "include" => "Include",
+                _ => "Characters"
+            };
+            var value = metadata.Groups[2].Value;
+            if (key == "Characters")
+            {
+                value = string.Join(", ", value.Split(',', StringSplitOptions.TrimEntries | StringSplitOptions.RemoveEmptyEntries));
+            }
+            return $"{key}: {value}";
+        }
+        
+        return FormatDialogLine(trimmed);
+    }
+    
+    private static string FormatDialogLine(string trimmed)
+    {
+        var colon = trimmed.IndexOf(':');
+        if (colon <= 0)
+        {
+            return trimmed;
+        }
+        
+        var name = trimmed[..colon].TrimEnd();
+        var rest = trimmed[(colon + 1)..].Trim();
+        if (name.Length == 0 || rest.Length == 0)
+        {
+            return trimmed;
+        }
+        
+        // Metadata must be the last thing on the line, otherwise leave it to the compiler
+        var metaStart = rest.IndexOf('{');
+        if (metaStart < 0 || !rest.EndsWith('}') || rest.IndexOf('}') != rest.Length - 1)
+        {
+            return $"{name}: {rest}";
+        }
+        
+        var text = rest[..metaStart].TrimEnd();
+        var meta = FormatMetadata(rest[metaStart..]);
+        return text.Length > 0 ? $"{name}: {text} {meta}" : $"{name}: {meta}";
+    }
+    
+    private static string FormatMetadata(string metadata)
+    {
+        var builder = new StringBuilder("{");
+        foreach (var entry in new MetadataParser(metadata))
+        {
+            if (builder.Length > 1)
+            {
+                builder.Append(", ");
+            }
+            builder.Append(entry.Key).Append(": ").Append(entry.Value);
+        }
+        builder.Append('}');
+        
+        // Entries without ':' are skipped by MetadataParser, never drop them
+        var formatted = builder.ToString();
+        return WithoutWhitespace(formatted) == WithoutWhitespace(metadata) ? formatted : metadata;
+    }
+    
+    private static string WithoutWhitespace(string text)
+    {
+        return string.Concat(text.Where(c => !char.IsWhiteSpace(c)));
+    }
+    
+    // Strict, so a Latin-1 file fails instead of having its bytes replaced with U+FFFD
+    private static readonly UTF8Encoding StrictUtf8 = new(false, true);
+    
+    // Nothing is written until a line actually changes. Then the file is streamed again into
+    // a temporary file next to it, which replaces the original. Files that aren't UTF-8 are
+    // left alone, like --fix does
+    public static FormatResult FormatFile(string path)
+    {
+        var tempPath = path + ".fmt~";
+        try
+        {
+            if (!NeedsFormatting(path))
+            {
+                return FormatResult.Unchanged;
+            }
+            
+            var (newLine, finalNewLine) = DetectNewLine(path);
+            using (var reader = OpenReader(path, out var hasBom))
+            using (var writer = new StreamWriter(tempPath, false, new UTF8Encoding(hasBom)))
+            {
+                var first = true;
+                while (reader.ReadLine() is { } line)
+                {
+                    if (!first)
+                    {
+                        writer.Write(newLine);
+                    }
+                    writer.Write(FormatLine(line));
+                    first = false;
+                }
+                
+                // Keep a missing final newline missing
+                if (!first && finalNewLine)
+                {
+                    writer.Write(newLine);
+                }
+            }
+            
+            File.Move(tempPath, path, true);
+            return FormatResult.Formatted;
+        }
+        catch (DecoderFallbackException)
+        {
+            return FormatResult.NotUtf8;
+        }
+        finally
+        {
+            if (File.Exists(tempPath))
+            {
+                File.Delete(tempPath);
+            }
+        }
+    }
+    
+    private static bool NeedsFormatting(string path)
+    {
+        using var reader = OpenReader(path, out _);
+        while (reader.ReadLine() is { } line)
+        {
+            if (!string.Equals(line, FormatLine(line), StringComparison.Ordinal))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    // A UTF-8 BOM is skipped here and written back by the caller
+    private static StreamReader OpenReader(string path, out bool hasBom)
+    {
+        var stream = File.OpenRead(path);
+        Span<byte> bom = stackalloc byte[3];
+        hasBom = stream.Read(bom) == 3 && bom.SequenceEqual(Encoding.UTF8.Preamble);
+        if (!hasBom)
+        {
+            stream.Position = 0;
+        }
+        return new StreamReader(stream, StrictUtf8, false);
+    }
+    
+    // Keeps "\r\n" files as they are, everything else gets '\n'
+    private static (string NewLine, bool FinalNewLine) DetectNewLine(string path)
+    {
+        Span<byte> buffer = stackalloc byte[4096];
+        using var stream = File.OpenRead(path);
+        var read = stream.Read(buffer);
+        var newLine = buffer[..read].IndexOf((byte)'\n');
+        
+        var finalNewLine = false;
+        if (stream.Length > 0)
+        {
+            stream.Position = stream.Length - 1;
+            finalNewLine = stream.ReadByte() == '\n';
+        }
+        return (newLine > 0 && buffer[newLine - 1] == '\r' ? "\r\n" : "\n", finalNewLine);
+    }
+    
+    // Formats all files in parallel
+    public static FormatResult[] FormatFiles(IReadOnlyList<string> files)
+    {
+        var results = new FormatResult[files.Count];
+        Parallel.For(0, files.Count, i => results[i] = FormatFile(files[i]));
+        return results;
+    }
+}
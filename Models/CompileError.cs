@@ -1,14 +1,49 @@
 namespace DialScript.Models;
 
-public class CompileError
+// Kept small on purpose: message and hint are formatted from the code only when rendered
+public readonly struct CompileError
 {
-    public int LineNumber { get; init; }
+    public CompileError(DiagnosticCode code, SourceSpan span, string? lineContent = null, 
+        int errorPosition = -1, string? argument = null, int count = 1, IArgumentFormatter? formatter = null)
+    {
+        Code = code;
+        Span = span;
+        LineContent = lineContent;
+        ErrorPosition = errorPosition;
+        Argument = argument;
+        Count = count;
+        Formatter = formatter;
+    }
     
-    public string Message { get; init; } = string.Empty;
+    public DiagnosticCode Code { get; }
     
-    public string? Hint { get; init; }
+    // Exact range of the offending token (or the whole line)
+    public SourceSpan Span { get; }
     
-    public string? LineContent { get; init; }
+    public int LineNumber => Span.Start.Line;
     
-    public int ErrorPosition { get; init; } = -1;
+    public string? LineContent { get; }
+    
+    // Column of the caret shown under the line, -1 if none
+    public int ErrorPosition { get; }
+    
+    public string? Argument { get; }
+    
+    // Turns Argument into message text on render, for text that is costly to build (suggestions)
+    public IArgumentFormatter? Formatter { get; }
+    
+    // How many identical errors this entry stands for (see CompilerSettings.CollapseErrors)
+    public int Count { get; }
+    
+    public string Id => Diagnostics.Id(Code);
+    
+    public string Message => Diagnostics.FormatMessage(Code, 
+        Argument != null && Formatter != null ? Formatter.Format(Argument) : Argument);
+    
+    public string? Hint => Diagnostics.Describe(Code).Hint;
+    
+    public CompileError WithCount(int count)
+    {
+        return new CompileError(Code, Span, LineContent, ErrorPosition, Argument, count, Formatter);
+    }
 }
@@ -0,0 +1,71 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+namespace DialScript.Models;
+
+// Stable diagnostic IDs (printed as DSxxxx). Never renumber, only add new ones
+public enum DiagnosticCode : ushort
+{
+    // Input
+    FileNotFound = 1,                  // DS0001
+    FixesNotApplied = 2,               // DS0002
+    ExportFailed = 3,                  // DS0003
+    ReadFailed = 4,                    // DS0004
+    
+    // Dialog lines
+    UnknownCharacter = 101,            // DS0101
+    StrayDialogLine = 102,             // DS0102
+    MissingMetadataBrace = 103,        // DS0103
+    EmptyLineInDialog = 104,           // DS0104
+    InvalidLineInDialog = 105,         // DS0105
+    UnknownSyntax = 106,               // DS0106
+    EmptyName = 107,                   // DS0107
+    MissingColon = 108,                // DS0108
+    InvalidDialogFormat = 109,         // DS0109
+    LeadingSpace = 110,                // DS0110
+    NoSpaceAfterColon = 111,           // DS0111
+    EmptyText = 112,                   // DS0112
+    TextTooLong = 113,                 // DS0113
+    UnknownMetadataKey = 114,          // DS0114
+    InvalidMetadataValue = 115,        // DS0115
+    InvalidMarkup = 116,               // DS0116
+    TextOverflow = 117,                // DS0117
+    WordTooWide = 118,                 // DS0118
+    BannedTerm = 119,                  // DS0119
+    UnknownWord = 120,                 // DS0120
+    
+    // Headers
+    DuplicateScene = 201,              // DS0201
+    InvalidSceneNumber = 202,          // DS0202
+    DialogWithoutScene = 203,          // DS0203
+    InvalidDialogNumber = 204,         // DS0204
+    TypoScene = 205,                   // DS0205
+    TypoDialog = 206,                  // DS0206
+    UnclosedBracket = 207,             // DS0207
+    ExtraSpaceInHeader = 208,          // DS0208
+    HeaderNumberTooLarge = 209,        // DS0209
+    
+    // Scene metadata
+    LevelOutsideScene = 301,           // DS0301
+    LevelAfterDialog = 302,            // DS0302
+    DuplicateLevel = 303,              // DS0303
+    LocationOutsideScene = 304,        // DS0304
+    LocationAfterDialog = 305,         // DS0305
+    DuplicateLocation = 306,           // DS0306
+    CharactersOutsideScene = 307,      // DS0307
+    CharactersAfterDialog = 308,       // DS0308
+    DuplicateCharacters = 309,         // DS0309
+    TypoLevel = 310,                   // DS0310
+    TypoLocation = 311,                // DS0311
+    TypoCharacters = 312,              // DS0312
+    ExtraSpaceInMetadata = 313,        // DS0313
+    MissingScene = 314,                // DS0314
+    MissingLevel = 315,                // DS0315
+    MissingLocation = 316,             // DS0316
+    MissingCharacters = 317,           // DS0317
+    IncludeOutsideScene = 318,         // DS0318
+    IncludeAfterDialog = 319,          // DS0319
+    InvalidInclude = 320,              // DS0320
+    SchemaConflict = 321               // DS0321
+}
@@ -0,0 +1,83 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+namespace DialScript.Models;
+
+public readonly record struct DiagnosticDescriptor(string Message, string? Hint);
+
+// Message and hint texts for every diagnostic code. They are only looked up
+// when a diagnostic is actually rendered
+public static class Diagnostics
+{
+    public static string Id(DiagnosticCode code) => $"DS{(int)code:D4}";
+    
+    public static string FormatMessage(DiagnosticCode code, string? argument)
+    {
+        var message = Describe(code).Message;
+        return argument != null ? string.Format(message, argument) : message;
+    }
+    
+    public static DiagnosticDescriptor Describe(DiagnosticCode code) => code switch
+    {
+        DiagnosticCode.FileNotFound => new("File not found: {0}", null),
+        DiagnosticCode.FixesNotApplied => new("Fixes not applied: {0} is not a UTF-8 file", "convert the file to UTF-8 to use --fix"),
+        DiagnosticCode.ExportFailed => new("Export failed: {0}", "check that the script's directory is writable"),
+        DiagnosticCode.ReadFailed => new("Cannot read file: {0}", null),
+        
+        DiagnosticCode.UnknownCharacter => new("Unknown character", "add this character to Characters"),
+        DiagnosticCode.StrayDialogLine => new("Stray dialog line", "add [Dialog.1] before this line"),
+        DiagnosticCode.MissingMetadataBrace => new("Missing '}' in metadata", "close metadata with '}'"),
+        DiagnosticCode.EmptyLineInDialog => new("Empty line inside dialog block", "remove empty lines between dialog lines"),
+        DiagnosticCode.InvalidLineInDialog => new("Invalid line in dialog", "use format: Name: Text"),
+        DiagnosticCode.UnknownSyntax => new("Unknown syntax", "check spelling or use: [Scene.N], [Dialog.N], Name: Text"),
+        DiagnosticCode.EmptyName => new("Empty name before ':'", "add character name, e.g. Alan: Hello"),
+        DiagnosticCode.MissingColon => new("Missing ':' in dialog", "use format: Name: Text"),
+        DiagnosticCode.InvalidDialogFormat => new("Wrong dialog format", "use format: Name: Text"),
+        DiagnosticCode.LeadingSpace => new("Leading space in dialog line", "character name must start at the beginning of the line"),
+        DiagnosticCode.NoSpaceAfterColon => new("Missing space after ':'", "add a space after the colon, e.g. 'Name: Text'"),
+        DiagnosticCode.EmptyText => new("Empty dialog text", "add text after the colon"),
+        DiagnosticCode.UnknownMetadataKey => new("Unknown metadata key '{0}'", "declare the key in the schema file"),
+        DiagnosticCode.InvalidMetadataValue => new("Invalid metadata value '{0}'", "use a value allowed by the schema file"),
+        DiagnosticCode.InvalidMarkup => new("Invalid markup tag", "close [b], [i], [color=..], [speed=..] in reverse order; [pause=ms] takes a number"),
+        DiagnosticCode.TextOverflow => new("Dialog text doesn't fit the text box: {0}", "shorten the text or split it into two lines"),
+        DiagnosticCode.WordTooWide => new("Word wider than the text box", "shorten the word or add a space where it may break"),
+        DiagnosticCode.BannedTerm => new("Banned term '{0}'", "reword the line for the target age rating"),
+        DiagnosticCode.UnknownWord => new("Unknown word {0}", "fix the spelling or add the word to the allowlist"),
+        DiagnosticCode.TextTooLong => new("Dialog text longer than {0} characters", "shorten the text or split it into two lines"),
+        
+        DiagnosticCode.DuplicateScene => new("Only one [Scene.X] allowed", "remove extra scene declarations"),
+        DiagnosticCode.InvalidSceneNumber => new("Scene number must be > 0", "use [Scene.1], [Scene.2], etc."),
+        DiagnosticCode.DialogWithoutScene => new("Dialog without [Scene.X]", "add [Scene.1] before this dialog"),
+        DiagnosticCode.InvalidDialogNumber => new("Dialog number must be > 0", "use [Dialog.1], [Dialog.2], etc."),
+        DiagnosticCode.TypoScene => new("Did you mean [Scene.N]?", "check spelling"),
+        DiagnosticCode.TypoDialog => new("Did you mean [Dialog.N]?", "check spelling"),
+        DiagnosticCode.UnclosedBracket => new("Missing ']'", "close header with ']'"),
+        DiagnosticCode.ExtraSpaceInHeader => new("Extra space in header", "use [Scene.1] or [Dialog.1] without spaces"),
+        DiagnosticCode.HeaderNumberTooLarge => new("Header number must be at most {0}", "use a smaller number"),
+        
+        DiagnosticCode.LevelOutsideScene => new("Level outside scene", "move Level: x inside [Scene.X] block"),
+        DiagnosticCode.LevelAfterDialog => new("Level after dialog", "move Level: x before [Dialog.X]"),
+        DiagnosticCode.DuplicateLevel => new("Duplicate Level", "remove extra Level definition"),
+        DiagnosticCode.LocationOutsideScene => new("Location outside scene", "move Location: x inside [Scene.X] block"),
+        DiagnosticCode.LocationAfterDialog => new("Location after dialog", "move Location: x before [Dialog.X]"),
+        DiagnosticCode.DuplicateLocation => new("Duplicate Location", "remove extra Location definition"),
+        DiagnosticCode.CharactersOutsideScene => new("Characters outside scene", "move Characters: inside [Scene.X] block"),
+        DiagnosticCode.CharactersAfterDialog => new("Characters after dialog", "move Characters: before [Dialog.X]"),
+        DiagnosticCode.DuplicateCharacters => new("Duplicate Characters", "remove extra Characters definition"),
+        DiagnosticCode.TypoLevel => new("Did you mean 'Level:'?", "check spelling"),
+        DiagnosticCode.TypoLocation => new("Did you mean 'Location:'?", "check spelling"),
+        DiagnosticCode.TypoCharacters => new("Did you mean 'Characters:'?", "check spelling"),
+        DiagnosticCode.ExtraSpaceInMetadata => new("Extra space before ':'", "use 'Level:', 'Location:', 'Characters:' without spaces"),
+        DiagnosticCode.MissingScene => new("Missing [Scene.X]", "add [Scene.1] at the beginning of file"),
+        DiagnosticCode.MissingLevel => new("Missing Level", "add 'Level: N' after [Scene.X]"),
+        DiagnosticCode.MissingLocation => new("Missing Location", "add 'Location: name' after [Scene.X]"),
+        DiagnosticCode.MissingCharacters => new("Missing Characters", "add 'Characters: Name1, Name2' after [Scene.X]"),
+        DiagnosticCode.IncludeOutsideScene => new("Include outside scene", "move Include: inside [Scene.X] block"),
+        DiagnosticCode.IncludeAfterDialog => new("Include after dialog", "move Include: before [Dialog.X]"),
+        DiagnosticCode.InvalidInclude => new("Invalid include: {0}", "the path is relative to the including file"),
+        DiagnosticCode.SchemaConflict => new("Conflicting schema key '{0}'", "declare the key the same way in every included schema"),
+        
+        _ => new(code.ToString(), null)
+    };
+}
@@ -0,0 +1,12 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+namespace DialScript.Models;
+
+// Formats a diagnostic argument when the error is rendered. Implementations are shared across
+// files and threads, like the rules that report them
+public interface IArgumentFormatter
+{
+    string Format(string argument);
+}
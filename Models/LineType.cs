@@ -12,6 +12,7 @@ public enum LineType
     Level,                       // Level header line
     Location,                    // Location header line
     Characters,                  // Characters header line
+    Include,                     // Include header line
 
     // Dialog line
     Dialog,                      // Dialog line
@@ -34,6 +35,8 @@ public enum LineType
     ErrorTypoLocation,           // Did you mean 'Location:'?
     ErrorTypoCharacters,         // Did you mean 'Characters:'?
     ErrorExtraSpaceInHeader,     // Extra space in header
+    ErrorNumberTooLarge,         // Header number doesn't fit in an int
     ErrorExtraSpaceInMetadata,   // Extra space before ':'
-    ErrorLeadingSpace            // Leading space in dialog line
+    ErrorLeadingSpace,           // Leading space in dialog line
+    ErrorInvalidMarkup           // Unknown value, unclosed or mismatched markup tag
 }
@@ -6,17 +6,84 @@ namespace DialScript.Models;
 
 public class ParsedLine
 {
+    private string? _characterName;
+    private string? _text;
+    private string? _metadata;
+    
     public LineType Type { get; set; } = LineType.Unknown;
     
     public int Number { get; set; }
     
     public string? Value { get; set; }
     
-    public string? CharacterName { get; set; }
+    // Dialog line payloads are slices of OriginalContent (see NameRange, TextRange, MetadataRange).
+    // The strings are only created on first use, rules and stats read the spans
+    public string? CharacterName
+    {
+        get => _characterName ??= Type == LineType.Dialog ? NameSpan.ToString() : null;
+        set => _characterName = value;
+    }
     
-    public string? Text { get; set; }
+    public string? Text
+    {
+        get => _text ??= Type == LineType.Dialog ? TextSpan.ToString() : null;
+        set => _text = value;
+    }
 
-    public string? Metadata { get; set; }
+    public string? Metadata
+    {
+        get => _metadata ??= HasMetadata ? MetadataSpan.ToString() : null;
+        set => _metadata = value;
+    }
+    
+    public ReadOnlySpan<char> NameSpan => Slice(NameRange);
+    
+    // Plain text: without markup if the line has any, then Text holds the stripped copy
+    public ReadOnlySpan<char> TextSpan => HasMarkup ? Text : Slice(TextRange);
+    
+    public ReadOnlySpan<char> MetadataSpan => Slice(MetadataRange);
+    
+    public bool HasMetadata => Type == LineType.Dialog && MetadataRange.Length > 0;
+    
+    // Styled pieces and pauses of Text, empty when the text has no markup (one default run)
+    public TextRun[] Runs { get; set; } = [];
+    
+    // Styles of this line's runs (TextRun.StyleId), TextStyle.Default first
+    public TextStyle[] Styles { get; set; } = [];
+    
+    // Tags were stripped from the text, even if no run is left ("[b][/b]")
+    public bool HasMarkup { get; set; }
+    
+    // Column in OriginalContent of an offset into TextSpan. With markup an offset maps into the
+    // run holding it, the end of a run maps to the end of its text (before a closing tag)
+    public int GetSourceColumn(int offset)
+    {
+        if (!HasMarkup)
+        {
+            return TextRange.Start + offset;
+        }
+        
+        var column = TextRange.Start;
+        foreach (var run in Runs)
+        {
+            if (run.Offset > offset)
+            {
+                break;
+            }
+            if (run.Length > 0)
+            {
+                column = TextRange.Start + run.SourceOffset + (offset - run.Offset);
+            }
+        }
+        return column;
+    }
+    
+    // Columns of a piece of TextSpan, tags inside of it included
+    public ColumnRange GetSourceRange(int offset, int length)
+    {
+        var start = GetSourceColumn(offset);
+        return length > 0 ? new ColumnRange(start, GetSourceColumn(offset + length - 1) + 1) : ColumnRange.Of(start, 0);
+    }
     
     public int LineNumber { get; set; }
     
@@ -24,13 +91,25 @@ public class ParsedLine
 
     public int ErrorPosition { get; set; } = -1;
     
+    // Column ranges of the recognized tokens inside OriginalContent
+    public ColumnRange ContentRange { get; set; }
+    
+    public ColumnRange ValueRange { get; set; }
+    
+    public ColumnRange NameRange { get; set; }
+    
+    public ColumnRange TextRange { get; set; }
+    
+    public ColumnRange MetadataRange { get; set; }
+    
     public static ParsedLine Success(LineType type, int lineNumber, string originalContent)
     {
         return new ParsedLine
         {
             Type = type,
             LineNumber = lineNumber,
-            OriginalContent = originalContent
+            OriginalContent = originalContent,
+            ContentRange = GetContentRange(originalContent)
         };
     }
 
@@ -41,9 +120,22 @@ public class ParsedLine
             Type = errorType,
             LineNumber = lineNumber,
             OriginalContent = originalContent,
-            ErrorPosition = errorPosition
+            ErrorPosition = errorPosition,
+            ContentRange = GetContentRange(originalContent)
         };
     }
+    
+    // Line without leading and trailing whitespace
+    public static ColumnRange GetContentRange(string line)
+    {
+        var start = line.Length - line.AsSpan().TrimStart().Length;
+        return new ColumnRange(start, Math.Max(start, line.AsSpan().TrimEnd().Length));
+    }
 
     public bool IsError => Type.ToString().StartsWith("Error");
+    
+    private ReadOnlySpan<char> Slice(ColumnRange range)
+    {
+        return range.Length > 0 ? OriginalContent.AsSpan(range.Start, range.Length) : ReadOnlySpan<char>.Empty;
+    }
 }
@@ -0,0 +1,21 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+namespace DialScript.Models;
+
+// Position in a source file: UTF-8 byte offset, 1-based line and 0-based UTF-16 column
+public readonly record struct SourcePosition(int Offset, int Line, int Column);
+
+public readonly record struct SourceSpan(SourcePosition Start, SourcePosition End)
+{
+    public int Length => End.Offset - Start.Offset;
+}
+
+// UTF-16 column range inside one line, end is exclusive
+public readonly record struct ColumnRange(int Start, int End)
+{
+    public int Length => End - Start;
+    
+    public static ColumnRange Of(int start, int length) => new(start, start + length);
+}
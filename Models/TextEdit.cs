@@ -0,0 +1,8 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+namespace DialScript.Models;
+
+// Replaces the text in Span with NewText (empty span = insertion)
+public readonly record struct TextEdit(SourceSpan Span, string NewText);
@@ -0,0 +1,25 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+namespace DialScript.Models;
+
+[Flags]
+public enum TextEmphasis : byte
+{
+    None = 0,
+    Bold = 1,                    // [b]...[/b]
+    Italic = 2                   // [i]...[/i]
+}
+
+// Look of a piece of dialog text. Speed is a multiplier of the typewriter speed (1 = normal)
+public readonly record struct TextStyle(TextEmphasis Emphasis, string? Color, float Speed)
+{
+    public static TextStyle Default { get; } = new(TextEmphasis.None, null, 1f);
+}
+
+// Piece of plain dialog text (Offset and Length in Text, markup removed) drawn with one style.
+// SourceOffset is where the piece starts in the written text, tags included. StyleId indexes
+// ParsedLine.Styles, so styles live and die with the parsed file.
+// A pause is an empty run: wait PauseMs before typing on from Offset
+public readonly record struct TextRun(int Offset, int Length, int SourceOffset, int StyleId, int PauseMs);
@@ -2,6 +2,12 @@
 // Licensed under the Apache License, Version 2.0
 // See: http://www.apache.org/licenses/LICENSE-2.0
 
+using System.Globalization;
+using DialScript.Analysis;
+using DialScript.Compiler;
+using DialScript.Formatting;
+using DialScript.Models;
+
 namespace DialScript.Output;
 
 public static class ConsoleOutput
@@ -30,9 +36,13 @@ public static class ConsoleOutput
         Console.WriteLine($"{BoldCyan}Compiling:{Reset} {filePath}");
     }
     
-    public static void PrintFooter(int totalLines, int errorCount)
+    public static void PrintFooter(int totalLines, int errorCount, bool stopped = false)
     {
-        if (errorCount == 0)
+        if (stopped)
+        {
+            Console.WriteLine($"{BoldRed}Parsing stopped:{Reset} {errorCount} error(s), maximum reached");
+        }
+        else if (errorCount == 0)
         {
             Console.WriteLine($"{BoldGreen}Parsing completed:{Reset} {totalLines} lines processed");
         }
@@ -77,6 +87,11 @@ public static class ConsoleOutput
         Console.WriteLine($"{Gray}{lineNumber,4} │   {Cyan}Characters:{Reset} {value}");
     }
     
+    public static void PrintInclude(int lineNumber, string value)
+    {
+        Console.WriteLine($"{Gray}{lineNumber,4} │   {Cyan}Include:{Reset} {value}");
+    }
+    
     public static void PrintDialogLine(int lineNumber, string name, string text, string? metadata = null)
     {
         if (metadata != null)
@@ -89,11 +104,26 @@ public static class ConsoleOutput
         }
     }
     
+    public static void PrintError(in CompileError error)
+    {
+        var message = error.Count > 1
+            ? $"{error.Message} ×{error.Count.ToString("N0", CultureInfo.InvariantCulture)}"
+            : error.Message;
+        PrintError(error.LineNumber, message, error.Hint, error.LineContent, error.ErrorPosition, error.Id);
+    }
+    
     public static void PrintError(int lineNumber, string message, string? hint = null, 
-        string? lineContent = null, int errorPosition = -1)
+        string? lineContent = null, int errorPosition = -1, string? id = null)
     {
         // Error message
-        Console.WriteLine($"{BoldRed}{lineNumber,4} │ ✗ {message}{Reset}");
+        if (id != null)
+        {
+            Console.WriteLine($"{BoldRed}{lineNumber,4} │ ✗ {message}{Reset} {Gray}[{id}]{Reset}");
+        }
+        else
+        {
+            Console.WriteLine($"{BoldRed}{lineNumber,4} │ ✗ {message}{Reset}");
+        }
         
         // String with that error
         if (!string.IsNullOrEmpty(lineContent))
@@ -116,6 +146,97 @@ public static class ConsoleOutput
         }
     }
 
+    public static void PrintStats(CorpusStats stats)
+    {
+        Console.WriteLine($"{BoldCyan}Corpus stats:{Reset} {stats.Files} file(s), {stats.TotalLines} lines");
+        Console.WriteLine($"  {BoldWhite}Dialog:{Reset} {stats.Dialog.Lines} lines, {stats.Dialog.Words} words, {stats.Dialog.Characters} characters");
+        
+        PrintStatsTable("Speaker", stats.BySpeaker);
+        PrintStatsTable("Scene", stats.ByScene);
+        PrintStatsTable("Location", stats.ByLocation);
+        PrintStatsTable("Level", stats.ByLevel);
+        
+        Console.WriteLine();
+        Console.WriteLine($"{BoldCyan}Emotion{Reset}");
+        foreach (var (emotion, count) in stats.Emotions.OrderByDescending(e => e.Value).ThenBy(e => e.Key, StringComparer.Ordinal))
+        {
+            Console.WriteLine($"  {Yellow}{emotion,-30}{Reset} {count,10}");
+        }
+        
+        Console.WriteLine();
+        Console.WriteLine($"{BoldCyan}Line length{Reset} {Gray}(characters){Reset}");
+        for (var i = 0; i < CorpusStats.HistogramBuckets; i++)
+        {
+            var from = i * CorpusStats.HistogramBucketSize;
+            var label = i == CorpusStats.HistogramBuckets - 1
+                ? $"{from}+"
+                : $"{from}-{from + CorpusStats.HistogramBucketSize - 1}";
+            Console.WriteLine($"  {label,-30} {stats.LineLengthHistogram[i],10}");
+        }
+    }
+    
+    private static void PrintStatsTable(string title, Dictionary<string, TextCounts> counts)
+    {
+        Console.WriteLine();
+        Console.WriteLine($"{BoldCyan}{title,-32}{Reset}{Gray}{"lines",10} {"words",10} {"chars",10}{Reset}");
+        foreach (var (key, entry) in counts.OrderBy(c => c.Key, StringComparer.Ordinal))
+        {
+            Console.WriteLine($"  {key,-30} {entry.Lines,10} {entry.Words,10} {entry.Characters,10}");
+        }
+    }
+
+    // Renders a result compiled in quiet mode (used by multi-file compilation)
+    public static void PrintResult(CompileResult result)
+    {
+        PrintHeader(result.FilePath);
+        foreach (var error in result.Errors)
+        {
+            PrintError(error);
+        }
+        if (result.FixedCount > 0)
+        {
+            PrintFixed(result.FixedCount);
+        }
+        PrintFooter(result.TotalLines, result.ErrorCount, result.Stopped);
+    }
+    
+    public static void PrintFixed(int fixCount)
+    {
+        Console.WriteLine($"{BoldGreen}Fixed:{Reset} {fixCount} issue(s)");
+    }
+    
+    public static void PrintSummary(PipelineSummary summary)
+    {
+        if (summary.Errors == 0)
+        {
+            Console.WriteLine($"{BoldGreen}Build completed:{Reset} {summary.Files} file(s), {summary.TotalLines} lines processed");
+        }
+        else
+        {
+            Console.WriteLine($"{BoldRed}Build broken:{Reset} {summary.Files} file(s), {summary.TotalLines} lines processed, {summary.Errors} error(s)");
+        }
+    }
+
+    public static void PrintFormatted(IReadOnlyList<string> files, FormatResult[] results)
+    {
+        var changed = 0;
+        for (var i = 0; i < files.Count; i++)
+        {
+            switch (results[i])
+            {
+                case FormatResult.Formatted:
+                    Console.WriteLine($"{Yellow}Formatted:{Reset} {files[i]}");
+                    changed++;
+                    break;
+                    
+                case FormatResult.NotUtf8:
+                    PrintErrorMessage($"{files[i]} is not a UTF-8 file, convert it to UTF-8 to format it");
+                    break;
+            }
+        }
+        Console.WriteLine($"{BoldGreen}Formatting completed:{Reset} {changed} of {files.Count} file(s) changed");
+    }
+    
     public static void PrintErrorMessage(string message)
     {
         Console.WriteLine($"{BoldRed}Error:{Reset} {message}");
@@ -129,13 +250,34 @@ public static class ConsoleOutput
     public static void PrintHelp(string version)
     {
         Console.WriteLine($"{BoldCyan}DialScript v{version}{Reset}");
-        Console.WriteLine($"{BoldWhite}Usage:{Reset} dialscript <filename.ds> [options]");
+        Console.WriteLine($"{BoldWhite}Usage:{Reset} dialscript <filename.ds|directory|->... [options]");
+        Console.WriteLine($"       dialscript @files.rsp [options]");
+        Console.WriteLine($"       dialscript check --since <rev> [options]");
+        Console.WriteLine($"       dialscript stats <directory>");
+        Console.WriteLine($"       dialscript fmt <filename.ds|directory>...");
         Console.WriteLine();
         Console.WriteLine($"{BoldWhite}Options:{Reset}");
-        Console.WriteLine($"  {BoldGreen}--verbose{Reset}    Enable verbose mode");
-        Console.WriteLine($"  {BoldGreen}--help{Reset}       Show this help message");
-        Console.WriteLine($"  {BoldGreen}--version{Reset}    Show version number");
-        Console.WriteLine($"  {BoldGreen}--example{Reset}    Show example .ds file");
+        Console.WriteLine($"  {BoldGreen}--verbose{Reset}            Enable verbose mode");
+        Console.WriteLine($"  {BoldGreen}--quiet{Reset}              Don't print diagnostics, only count them");
+        Console.WriteLine($"  {BoldGreen}--max-errors N{Reset}       Stop compiling a file after N errors");
+        Console.WriteLine($"  {BoldGreen}--collapse{Reset}           Report repeated identical errors once with a count");
+        Console.WriteLine($"  {BoldGreen}--fix{Reset}                Fix errors that have one obvious fix in place");
+        Console.WriteLine($"  {BoldGreen}--max-line-length N{Reset}  Report dialog text longer than N characters");
+        Console.WriteLine($"  {BoldGreen}--schema FILE{Reset}        Check line metadata against a schema file");
+        Console.WriteLine($"  {BoldGreen}--banned FILE{Reset}        Report dialog text containing terms from a list");
+        Console.WriteLine($"  {BoldGreen}--dictionary FILE{Reset}    Spell check dialog text against a word list");
+        Console.WriteLine($"  {BoldGreen}--allow FILE{Reset}         Extra words the spell check accepts (names, slang)");
+        Console.WriteLine($"  {BoldGreen}--layout FILE{Reset}        Break dialog text against a text box and font widths");
+        Console.WriteLine($"  {BoldGreen}--emit graph{Reset}         Write each script's dialog flow next to it");
+        Console.WriteLine($"  {BoldGreen}--emit html|md{Reset}       Write a screenplay report with diagnostics next to each script");
+        Console.WriteLine($"  {BoldGreen}--emit text{Reset}          Write plain dialog text and markup runs as JSON");
+        Console.WriteLine($"  {BoldGreen}--graph-format F{Reset}     Graph format: dot (default) or graphml");
+        Console.WriteLine($"  {BoldGreen}--help{Reset}               Show this help message");
+        Console.WriteLine($"  {BoldGreen}--version{Reset}            Show version number");
+        Console.WriteLine($"  {BoldGreen}--example{Reset}            Show example .ds file");
+        Console.WriteLine($"  {BoldGreen}--files-from FILE{Reset}    Read input paths from FILE ('-' for stdin)");
+        Console.WriteLine($"  {BoldGreen}--jobs N{Reset}             Parser and validator workers for directories");
+        Console.WriteLine($"  {BoldGreen}--stream{Reset}             Print each file as soon as all earlier files are done");
     }
     
     public static void PrintExample()
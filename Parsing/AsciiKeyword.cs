@@ -0,0 +1,85 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Runtime.InteropServices;
+
+namespace DialScript.Parsing;
+
+// Case-insensitive prefix match for a fixed ASCII keyword such as "[scene." or "level:".
+// The keyword is packed four UTF-16 chars per ulong, so "[scene." is two 64-bit compares
+// (the last block overlaps the previous one). ASCII letters are folded by OR-ing 0x20 into
+// their lanes only; text with a non-ASCII char in the compared window goes through
+// OrdinalIgnoreCase instead
+public sealed class AsciiKeyword
+{
+    private const int CharsPerBlock = sizeof(ulong) / sizeof(char);
+
+    // High bits of every UTF-16 lane, set for anything outside 0x00-0x7F
+    private const ulong NonAsciiMask = 0xFF80_FF80_FF80_FF80;
+
+    private readonly string _keyword;
+    private readonly ulong[] _blocks;
+    private readonly ulong[] _foldMasks;
+
+    public AsciiKeyword(string keyword)
+    {
+        if (keyword.Length < CharsPerBlock || keyword.Any(c => !char.IsAscii(c)))
+        {
+            throw new ArgumentException("keyword must be ASCII and at least 4 characters long", nameof(keyword));
+        }
+
+        _keyword = keyword.ToLowerInvariant();
+        var blockCount = (_keyword.Length + CharsPerBlock - 1) / CharsPerBlock;
+        _blocks = new ulong[blockCount];
+        _foldMasks = new ulong[blockCount];
+
+        Span<char> fold = stackalloc char[CharsPerBlock];
+        for (var block = 0; block < blockCount; block++)
+        {
+            var chars = _keyword.AsSpan(BlockStart(block), CharsPerBlock);
+            for (var lane = 0; lane < CharsPerBlock; lane++)
+            {
+                fold[lane] = char.IsAsciiLetter(chars[lane]) ? (char)0x20 : (char)0;
+            }
+            _blocks[block] = Pack(chars);
+            _foldMasks[block] = Pack(fold);
+        }
+    }
+
+    public int Length => _keyword.Length;
+
+    public bool IsPrefixOf(ReadOnlySpan<char> text)
+    {
+        if (text.Length < _keyword.Length)
+        {
+            return false;
+        }
+
+        for (var block = 0; block < _blocks.Length; block++)
+        {
+            var value = Pack(text.Slice(BlockStart(block), CharsPerBlock));
+            if ((value & NonAsciiMask) != 0)
+            {
+                return text.StartsWith(_keyword, StringComparison.OrdinalIgnoreCase);
+            }
+            if ((value | _foldMasks[block]) != _blocks[block])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Blocks start every 4 chars, the last one is moved back to end at the last keyword char
+    private int BlockStart(int block)
+    {
+        return Math.Min(block * CharsPerBlock, _keyword.Length - CharsPerBlock);
+    }
+
+    private static ulong Pack(ReadOnlySpan<char> chars)
+    {
+        return MemoryMarshal.Read<ulong>(MemoryMarshal.AsBytes(chars));
+    }
+}
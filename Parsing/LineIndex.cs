@@ -0,0 +1,113 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Text;
+using DialScript.Models;
+
+namespace DialScript.Parsing;
+
+// Byte offsets of line starts, so offsets and line/column positions convert with a binary
+// search instead of re-scanning the text. Columns are UTF-16, offsets are UTF-8 bytes
+public sealed class LineIndex
+{
+    private readonly int[] _lineStarts;
+    private readonly string[] _lines;
+    
+    internal LineIndex(int[] lineStarts, string[] lines, bool isFileOffsets = false)
+    {
+        _lineStarts = lineStarts;
+        _lines = lines;
+        IsFileOffsets = isFileOffsets;
+    }
+    
+    public int LineCount => _lines.Length;
+    
+    // Offsets are those of the bytes on disk (a valid UTF-8 file), so edits can be written back.
+    // Otherwise they are computed from the decoded lines (UTF-16 files, stdin)
+    public bool IsFileOffsets { get; }
+    
+    // Builds the index for lines that were split without their terminators (assumes '\n')
+    public static LineIndex FromLines(string[] lines)
+    {
+        var lineStarts = new int[lines.Length];
+        var offset = 0;
+        for (var i = 0; i < lines.Length; i++)
+        {
+            lineStarts[i] = offset;
+            offset += ByteCount(lines[i]) + 1;
+        }
+        return new LineIndex(lineStarts, lines);
+    }
+    
+    public int GetLineStart(int lineNumber) => _lineStarts[lineNumber - 1];
+    
+    // 1-based line that contains the offset
+    public int GetLineNumber(int offset)
+    {
+        var index = Array.BinarySearch(_lineStarts, offset);
+        return index >= 0 ? index + 1 : Math.Max(1, ~index);
+    }
+    
+    public SourcePosition GetPosition(int offset)
+    {
+        if (_lines.Length == 0)
+        {
+            return new SourcePosition(0, 1, 0);
+        }
+        
+        var lineNumber = GetLineNumber(offset);
+        var line = _lines[lineNumber - 1];
+        var byteColumn = offset - _lineStarts[lineNumber - 1];
+        
+        // ASCII lines: bytes and UTF-16 units are the same
+        if (Ascii.IsValid(line))
+        {
+            return new SourcePosition(offset, lineNumber, Math.Min(byteColumn, line.Length));
+        }
+        
+        var column = 0;
+        var bytes = 0;
+        while (column < line.Length && bytes < byteColumn)
+        {
+            Rune.DecodeFromUtf16(line.AsSpan(column), out var rune, out var charsConsumed);
+            bytes += rune.Utf8SequenceLength;
+            column += charsConsumed;
+        }
+        return new SourcePosition(offset, lineNumber, column);
+    }
+    
+    public SourcePosition GetPosition(int lineNumber, int column)
+    {
+        if (lineNumber < 1 || lineNumber > _lines.Length)
+        {
+            var end = _lines.Length == 0 ? 0 : _lineStarts[^1] + ByteCount(_lines[^1]);
+            return new SourcePosition(end, Math.Max(1, lineNumber), 0);
+        }
+        
+        var line = _lines[lineNumber - 1];
+        column = Math.Clamp(column, 0, line.Length);
+        var offset = _lineStarts[lineNumber - 1] + ByteCount(line.AsSpan(0, column));
+        return new SourcePosition(offset, lineNumber, column);
+    }
+    
+    // Position right after the last character of the file
+    public SourcePosition GetEnd()
+    {
+        if (_lines.Length == 0)
+        {
+            return default;
+        }
+        return GetPosition(_lines.Length, _lines[^1].Length);
+    }
+    
+    public SourceSpan GetSpan(int lineNumber, ColumnRange range)
+    {
+        return new SourceSpan(GetPosition(lineNumber, range.Start), GetPosition(lineNumber, range.End));
+    }
+    
+    private static int ByteCount(ReadOnlySpan<char> text)
+    {
+        return Ascii.IsValid(text) ? text.Length : Encoding.UTF8.GetByteCount(text);
+    }
+}
@@ -5,21 +5,20 @@ using DialScript.Models;
 
 public static partial class LineParser
 {
+    // Keywords are matched with ASCII case folding, see AsciiKeyword
+    private static readonly AsciiKeyword SceneKeyword = new("[scene.");
+    private static readonly AsciiKeyword DialogKeyword = new("[dialog.");
+    private static readonly AsciiKeyword LevelKeyword = new("level:");
+    private static readonly AsciiKeyword LocationKeyword = new("location:");
+    private static readonly AsciiKeyword CharactersKeyword = new("characters:");
+    private static readonly AsciiKeyword IncludeKeyword = new("include:");
     
-    [GeneratedRegex(@"^\[Scene\.(\d+)\]$", RegexOptions.IgnoreCase)]
-    private static partial Regex ScenePattern();
-    
-    [GeneratedRegex(@"^\[Dialog\.(\d+)\]$", RegexOptions.IgnoreCase)]
-    private static partial Regex DialogHeaderPattern();
-    
-    [GeneratedRegex(@"^Level:\s*(.+)$", RegexOptions.IgnoreCase)]
-    private static partial Regex LevelPattern();
-    
-    [GeneratedRegex(@"^Location:\s*(.+)$", RegexOptions.IgnoreCase)]
-    private static partial Regex LocationPattern();
-    
-    [GeneratedRegex(@"^Characters:\s*(.+)$", RegexOptions.IgnoreCase)]
-    private static partial Regex CharactersPattern();
+    // Prefixes of the typo checks
+    private static readonly AsciiKeyword SceneTypo = new("scene");
+    private static readonly AsciiKeyword DialogTypo = new("dialog");
+    private static readonly AsciiKeyword LevelTypo = new("leve");
+    private static readonly AsciiKeyword LocationTypo = new("locatio");
+    private static readonly AsciiKeyword CharactersTypo = new("character");
     
     [GeneratedRegex(@"^([^:]+):\s+(.+?)(?:\s*(\{[^}]+\}))?$")]
     private static partial Regex DialogPattern();
@@ -44,26 +43,31 @@ public static partial class LineParser
             return ParsedLine.Success(LineType.Empty, lineNumber, originalLine);
         }
         
+        var contentRange = ParsedLine.GetContentRange(originalLine);
+        
         // Comment
         if (trimmedLine.StartsWith("//"))
         {
+            var value = trimmedLine[2..].TrimStart();
             return new ParsedLine
             {
                 Type = LineType.Comment,
                 LineNumber = lineNumber,
                 OriginalContent = originalLine,
-                Value = trimmedLine[2..].TrimStart()
+                Value = value,
+                ContentRange = contentRange,
+                ValueRange = new ColumnRange(contentRange.End - value.Length, contentRange.End)
             };
         }
         
         // Header
         if (trimmedLine.StartsWith('['))
         {
-            return ParseHeader(trimmedLine, lineNumber, originalLine);
+            return ParseHeader(trimmedLine, lineNumber, originalLine, contentRange);
         }
         
         // Metadata
-        var metadataResult = TryParseMetadata(trimmedLine, lineNumber, originalLine);
+        var metadataResult = TryParseMetadata(trimmedLine, lineNumber, originalLine, contentRange);
         if (metadataResult != null)
         {
             return metadataResult;
@@ -73,7 +77,7 @@ public static partial class LineParser
         return ParseDialogLine(line, lineNumber, originalLine);
     }
     
-    private static ParsedLine ParseHeader(string trimmedLine, int lineNumber, string originalLine)
+    private static ParsedLine ParseHeader(string trimmedLine, int lineNumber, string originalLine, ColumnRange contentRange)
     {
         // Check for unclosed brackets
         if (!trimmedLine.Contains(']'))
@@ -82,10 +86,13 @@ public static partial class LineParser
         }
         
         // [Scene.N]
-        var sceneMatch = ScenePattern().Match(trimmedLine);
-        if (sceneMatch.Success)
+        if (TryMatchHeader(trimmedLine, SceneKeyword, out var sceneDigits))
         {
-            var number = int.Parse(sceneMatch.Groups[1].Value);
+            var numberRange = ColumnRange.Of(contentRange.Start + SceneKeyword.Length, sceneDigits.Length);
+            if (!TryParseNumber(sceneDigits, out var number))
+            {
+                return NumberTooLarge(lineNumber, originalLine, contentRange, numberRange);
+            }
             if (number <= 0)
             {
                 return ParsedLine.Error(LineType.ErrorTypoScene, lineNumber, originalLine, 7);
@@ -96,15 +103,20 @@ public static partial class LineParser
                 Type = LineType.Scene,
                 LineNumber = lineNumber,
                 OriginalContent = originalLine,
-                Number = number
+                Number = number,
+                ContentRange = contentRange,
+                ValueRange = numberRange
             };
         }
         
         // [Dialog.N]
-        var dialogMatch = DialogHeaderPattern().Match(trimmedLine);
-        if (dialogMatch.Success)
+        if (TryMatchHeader(trimmedLine, DialogKeyword, out var dialogDigits))
         {
-            var number = int.Parse(dialogMatch.Groups[1].Value);
+            var numberRange = ColumnRange.Of(contentRange.Start + DialogKeyword.Length, dialogDigits.Length);
+            if (!TryParseNumber(dialogDigits, out var number))
+            {
+                return NumberTooLarge(lineNumber, originalLine, contentRange, numberRange);
+            }
             if (number <= 0)
             {
                 return ParsedLine.Error(LineType.ErrorTypoDialog, lineNumber, originalLine, 8);
@@ -115,7 +127,9 @@ public static partial class LineParser
                 Type = LineType.DialogHeader,
                 LineNumber = lineNumber,
                 OriginalContent = originalLine,
-                Number = number
+                Number = number,
+                ContentRange = contentRange,
+                ValueRange = numberRange
             };
         }
         
@@ -133,12 +147,12 @@ public static partial class LineParser
             
             // Check for missing spaces before ':'
             // TODO: add more typo patterns
-            if (SceneTypoPattern().IsMatch(content) || content.StartsWith("scene", StringComparison.OrdinalIgnoreCase))
+            if (SceneTypoPattern().IsMatch(content) || SceneTypo.IsPrefixOf(content))
             {
                 return ParsedLine.Error(LineType.ErrorTypoScene, lineNumber, originalLine, 1);
             }
             
-            if (DialogTypoPattern().IsMatch(content) || content.StartsWith("dialog", StringComparison.OrdinalIgnoreCase))
+            if (DialogTypoPattern().IsMatch(content) || DialogTypo.IsPrefixOf(content))
             {
                 return ParsedLine.Error(LineType.ErrorTypoDialog, lineNumber, originalLine, 1);
             }
@@ -147,66 +161,54 @@ public static partial class LineParser
         return ParsedLine.Error(LineType.ErrorTypoScene, lineNumber, originalLine, 1);
     }
     
-    private static ParsedLine? TryParseMetadata(string trimmedLine, int lineNumber, string originalLine)
+    private static ParsedLine? TryParseMetadata(string trimmedLine, int lineNumber, string originalLine, ColumnRange contentRange)
     {
-        // Level
-        var levelMatch = LevelPattern().Match(trimmedLine);
-        if (levelMatch.Success)
-        {
-            return new ParsedLine
-            {
-                Type = LineType.Level,
-                LineNumber = lineNumber,
-                OriginalContent = originalLine,
-                Value = levelMatch.Groups[1].Value.Trim()
-            };
-        }
-        
-        // Location
-        var locationMatch = LocationPattern().Match(trimmedLine);
-        if (locationMatch.Success)
+        // Level, Location, Characters, Include
+        var (keyword, type) = (char)(trimmedLine[0] | 0x20) switch
         {
-            return new ParsedLine
-            {
-                Type = LineType.Location,
-                LineNumber = lineNumber,
-                OriginalContent = originalLine,
-                Value = locationMatch.Groups[1].Value.Trim()
-            };
-        }
+            'l' when LevelKeyword.IsPrefixOf(trimmedLine) => (LevelKeyword, LineType.Level),
+            'l' when LocationKeyword.IsPrefixOf(trimmedLine) => (LocationKeyword, LineType.Location),
+            'c' when CharactersKeyword.IsPrefixOf(trimmedLine) => (CharactersKeyword, LineType.Characters),
+            'i' when IncludeKeyword.IsPrefixOf(trimmedLine) => (IncludeKeyword, LineType.Include),
+            _ => ((AsciiKeyword?)null, LineType.Unknown)
+        };
         
-        // Characters
-        var charactersMatch = CharactersPattern().Match(trimmedLine);
-        if (charactersMatch.Success)
+        if (keyword != null)
         {
-            return new ParsedLine
+            var value = trimmedLine.AsSpan(keyword.Length).TrimStart();
+            if (value.Length > 0)
             {
-                Type = LineType.Characters,
-                LineNumber = lineNumber,
-                OriginalContent = originalLine,
-                Value = charactersMatch.Groups[1].Value.Trim()
-            };
+                return new ParsedLine
+                {
+                    Type = type,
+                    LineNumber = lineNumber,
+                    OriginalContent = originalLine,
+                    Value = value.ToString(),
+                    ContentRange = contentRange,
+                    ValueRange = ColumnRange.Of(contentRange.End - value.Length, value.Length)
+                };
+            }
         }
         
         // Check for typos in metadata headers
         // TODO: add more typo patterns
-        if (trimmedLine.StartsWith("leve", StringComparison.OrdinalIgnoreCase) && 
+        if (LevelTypo.IsPrefixOf(trimmedLine) && 
             trimmedLine.Contains(':') &&
-            !trimmedLine.StartsWith("level:", StringComparison.OrdinalIgnoreCase))
+            !LevelKeyword.IsPrefixOf(trimmedLine))
         {
             return ParsedLine.Error(LineType.ErrorTypoLevel, lineNumber, originalLine);
         }
         
-        if (trimmedLine.StartsWith("locatio", StringComparison.OrdinalIgnoreCase) && 
+        if (LocationTypo.IsPrefixOf(trimmedLine) && 
             trimmedLine.Contains(':') &&
-            !trimmedLine.StartsWith("location:", StringComparison.OrdinalIgnoreCase))
+            !LocationKeyword.IsPrefixOf(trimmedLine))
         {
             return ParsedLine.Error(LineType.ErrorTypoLocation, lineNumber, originalLine);
         }
         
-        if (trimmedLine.StartsWith("character", StringComparison.OrdinalIgnoreCase) && 
+        if (CharactersTypo.IsPrefixOf(trimmedLine) && 
             trimmedLine.Contains(':') &&
-            !trimmedLine.StartsWith("characters:", StringComparison.OrdinalIgnoreCase))
+            !CharactersKeyword.IsPrefixOf(trimmedLine))
         {
             return ParsedLine.Error(LineType.ErrorTypoCharacters, lineNumber, originalLine);
         }
@@ -214,12 +216,14 @@ public static partial class LineParser
         return null;
     }
     
+    // Works on spans of the line and only records column ranges, CharacterName, Text and Metadata
+    // are sliced out of OriginalContent when someone asks for them
     private static ParsedLine ParseDialogLine(string line, int lineNumber, string originalLine)
     {
-        var trimmedLine = line.Trim();
+        var trimmedLine = line.AsSpan().Trim();
         
         // Check for leading spaces
-        if (line.Length > 0 && char.IsWhiteSpace(line[0]) && line.Trim().Contains(':'))
+        if (line.Length > 0 && char.IsWhiteSpace(line[0]) && trimmedLine.Contains(':'))
         {
             return ParsedLine.Error(LineType.ErrorLeadingSpace, lineNumber, originalLine);
         }
@@ -233,7 +237,7 @@ public static partial class LineParser
         
         // Name of the character
         var name = trimmedLine[..colonIndex].Trim();
-        if (string.IsNullOrEmpty(name))
+        if (name.IsEmpty)
         {
             return ParsedLine.Error(LineType.ErrorEmptyName, lineNumber, originalLine);
         }
@@ -249,44 +253,124 @@ public static partial class LineParser
         }
         
         var textPart = afterColon.Trim();
-        if (string.IsNullOrEmpty(textPart))
+        if (textPart.IsEmpty)
         {
             return ParsedLine.Error(LineType.ErrorEmptyText, lineNumber, originalLine);
         }
         
         // Metadata
-        string? metadata = null;
-        string text = textPart;
+        var metadataLength = 0;
+        var textLength = textPart.Length;
         
         var metaStart = textPart.IndexOf('{');
         if (metaStart >= 0)
         {
-            var metaEnd = textPart.IndexOf('}', metaStart);
+            var metaEnd = textPart[metaStart..].IndexOf('}');
             if (metaEnd < 0)
             {
                 return ParsedLine.Error(LineType.ErrorUnclosedBracket, lineNumber, originalLine, 
                     originalLine.IndexOf('{'));
             }
+            metaEnd += metaStart;
             
-            metadata = textPart[metaStart..(metaEnd + 1)];
-            text = textPart[..metaStart].Trim();
+            metadataLength = metaEnd + 1 - metaStart;
+            textLength = textPart[..metaStart].TrimEnd().Length;
             
             // Check that metadata is at the end of the line
-            var afterMeta = textPart[(metaEnd + 1)..].Trim();
-            if (!string.IsNullOrEmpty(afterMeta))
+            if (!textPart[(metaEnd + 1)..].IsWhiteSpace())
             {
                 return ParsedLine.Error(LineType.ErrorMetaNotAtEnd, lineNumber, originalLine);
             }
         }
         
+        // Token columns: trimmedLine starts at the first non-whitespace character of the line
+        var lead = line.Length - line.AsSpan().TrimStart().Length;
+        var textStart = lead + colonIndex + 1 + (afterColon.Length - afterColon.TrimStart().Length);
+        
+        // Inline markup, stripped from Text and kept as runs
+        string? plainText = null;
+        TextRun[] runs = [];
+        TextStyle[] styles = [];
+        if (MarkupParser.TryParse(textPart[..textLength], out var stripped, out var markupRuns, out var markupStyles, 
+                out var markupError))
+        {
+            if (markupError >= 0)
+            {
+                return ParsedLine.Error(LineType.ErrorInvalidMarkup, lineNumber, originalLine, textStart + markupError);
+            }
+            
+            // "[pause=300]" is as empty as no text at all
+            if (string.IsNullOrWhiteSpace(stripped))
+            {
+                return ParsedLine.Error(LineType.ErrorEmptyText, lineNumber, originalLine);
+            }
+            plainText = stripped;
+            runs = markupRuns;
+            styles = markupStyles;
+        }
+        
         return new ParsedLine
         {
             Type = LineType.Dialog,
             LineNumber = lineNumber,
             OriginalContent = originalLine,
-            CharacterName = name,
-            Text = text,
-            Metadata = metadata
+            ContentRange = new ColumnRange(lead, lead + trimmedLine.Length),
+            NameRange = ColumnRange.Of(lead, name.Length),
+            TextRange = ColumnRange.Of(textStart, textLength),
+            MetadataRange = metaStart >= 0 ? ColumnRange.Of(textStart + metaStart, metadataLength) : default,
+            Text = plainText,
+            Runs = runs,
+            Styles = styles,
+            HasMarkup = plainText != null
         };
     }
+    
+    // ASCII digits to int without allocating or looking at the culture, false on overflow
+    private static bool TryParseNumber(ReadOnlySpan<char> digits, out int value)
+    {
+        value = 0;
+        foreach (var c in digits)
+        {
+            var digit = c - '0';
+            if (value > (int.MaxValue - digit) / 10)
+            {
+                return false;
+            }
+            value = value * 10 + digit;
+        }
+        return true;
+    }
+    
+    private static ParsedLine NumberTooLarge(int lineNumber, string originalLine, ColumnRange contentRange, 
+        ColumnRange numberRange)
+    {
+        return new ParsedLine
+        {
+            Type = LineType.ErrorNumberTooLarge,
+            LineNumber = lineNumber,
+            OriginalContent = originalLine,
+            ErrorPosition = numberRange.Start,
+            ContentRange = contentRange,
+            ValueRange = numberRange
+        };
+    }
+    
+    // '[keyword' + ASCII digits + ']' and nothing else
+    private static bool TryMatchHeader(string trimmedLine, AsciiKeyword keyword, out ReadOnlySpan<char> digits)
+    {
+        digits = default;
+        if (!keyword.IsPrefixOf(trimmedLine) || !trimmedLine.EndsWith(']'))
+        {
+            return false;
+        }
+        
+        var number = trimmedLine.AsSpan(keyword.Length, Math.Max(0, trimmedLine.Length - keyword.Length - 1));
+        if (number.IsEmpty || number.ContainsAnyExceptInRange('0', '9'))
+        {
+            return false;
+        }
+        
+        digits = number;
+        return true;
+    }
 }
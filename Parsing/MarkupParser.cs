@@ -0,0 +1,210 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Globalization;
+using System.Text;
+using DialScript.Models;
+
+namespace DialScript.Parsing;
+
+// Inline markup in dialog text, tokenized once when the line is parsed:
+//
+//     Alan: Wait[pause=400]... [b]what[/b]? [color=#ff4040][speed=0.5]No way.[/speed][/color]
+//
+// Tags: [b], [i], [color=name|#rrggbb], [speed=multiplier] with their closing tags, and [pause=ms].
+// Anything else in brackets (e.g. "[sighs]") is plain text
+public static class MarkupParser
+{
+    private enum Tag
+    {
+        None,
+        Bold,
+        Italic,
+        Color,
+        Speed,
+        Pause
+    }
+
+    // False if the text has no markup at all, then the text and runs are left unset.
+    // TextRun.StyleId indexes styles, which starts with TextStyle.Default.
+    // errorOffset is the position in text of the first bad tag, or -1
+    public static bool TryParse(ReadOnlySpan<char> text, out string plainText, out TextRun[] runs, 
+        out TextStyle[] styles, out int errorOffset)
+    {
+        plainText = string.Empty;
+        runs = [];
+        styles = [];
+        errorOffset = -1;
+
+        if (!text.Contains('['))
+        {
+            return false;
+        }
+
+        var plain = new StringBuilder(text.Length);
+        var result = new List<TextRun>();
+        var open = new Stack<(Tag Tag, TextStyle Style)>();
+        // A line uses a handful of styles, a list beats hashing them
+        var lineStyles = new List<TextStyle> { TextStyle.Default };
+        var style = TextStyle.Default;
+        var styleId = 0;
+        var runStart = 0;
+        var runSource = 0;
+        var hasMarkup = false;
+        var position = 0;
+
+        while (position < text.Length)
+        {
+            var start = text[position..].IndexOf('[');
+            if (start < 0)
+            {
+                plain.Append(text[position..]);
+                break;
+            }
+            start += position;
+
+            var end = text[start..].IndexOf(']');
+            if (end < 0)
+            {
+                plain.Append(text[position..]);
+                break;
+            }
+            end += start;
+
+            var body = text[(start + 1)..end];
+            var closing = body.StartsWith("/");
+            var tag = GetTag(closing ? body[1..] : body, out var argument);
+            if (tag == Tag.None)
+            {
+                // Not markup, keep it as text
+                plain.Append(text[position..(end + 1)]);
+                position = end + 1;
+                continue;
+            }
+
+            hasMarkup = true;
+            plain.Append(text[position..start]);
+            position = end + 1;
+
+            // The text so far keeps the style it was written in
+            if (plain.Length > runStart)
+            {
+                result.Add(new TextRun(runStart, plain.Length - runStart, runSource, styleId, 0));
+                runStart = plain.Length;
+            }
+            runSource = position;
+
+            if (tag == Tag.Pause)
+            {
+                if (closing || !int.TryParse(argument, NumberStyles.None, CultureInfo.InvariantCulture, out var pause))
+                {
+                    errorOffset = start;
+                    return true;
+                }
+                result.Add(new TextRun(plain.Length, 0, position, styleId, pause));
+                continue;
+            }
+
+            if (closing)
+            {
+                if (!argument.IsEmpty || open.Count == 0 || open.Peek().Tag != tag)
+                {
+                    errorOffset = start;
+                    return true;
+                }
+                style = open.Pop().Style;
+            }
+            else
+            {
+                if (!TryApply(tag, argument, style, out var applied))
+                {
+                    errorOffset = start;
+                    return true;
+                }
+                open.Push((tag, style));
+                style = applied;
+            }
+            styleId = lineStyles.IndexOf(style);
+            if (styleId < 0)
+            {
+                styleId = lineStyles.Count;
+                lineStyles.Add(style);
+            }
+        }
+
+        if (!hasMarkup)
+        {
+            return false;
+        }
+
+        if (open.Count > 0)
+        {
+            errorOffset = text.Length;
+            return true;
+        }
+
+        if (plain.Length > runStart)
+        {
+            result.Add(new TextRun(runStart, plain.Length - runStart, runSource, styleId, 0));
+        }
+
+        plainText = plain.ToString();
+        runs = result.ToArray();
+        styles = lineStyles.ToArray();
+        return true;
+    }
+
+    // "b", "i", "color=red", ...; argument is the part after '='
+    private static Tag GetTag(ReadOnlySpan<char> body, out ReadOnlySpan<char> argument)
+    {
+        argument = default;
+        var equals = body.IndexOf('=');
+        var name = equals >= 0 ? body[..equals] : body;
+        if (equals >= 0)
+        {
+            argument = body[(equals + 1)..];
+        }
+
+        return name switch
+        {
+            "b" => Tag.Bold,
+            "i" => Tag.Italic,
+            "color" => Tag.Color,
+            "speed" => Tag.Speed,
+            "pause" => Tag.Pause,
+            _ => Tag.None
+        };
+    }
+
+    private static bool TryApply(Tag tag, ReadOnlySpan<char> argument, in TextStyle style, out TextStyle applied)
+    {
+        applied = style;
+        switch (tag)
+        {
+            case Tag.Bold:
+                applied = style with { Emphasis = style.Emphasis | TextEmphasis.Bold };
+                return argument.IsEmpty;
+
+            case Tag.Italic:
+                applied = style with { Emphasis = style.Emphasis | TextEmphasis.Italic };
+                return argument.IsEmpty;
+
+            case Tag.Color:
+                applied = style with { Color = argument.ToString() };
+                return !argument.IsEmpty;
+
+            case Tag.Speed:
+                if (!float.TryParse(argument, NumberStyles.AllowDecimalPoint, CultureInfo.InvariantCulture, out var speed) ||
+                    speed <= 0)
+                {
+                    return false;
+                }
+                applied = style with { Speed = speed };
+                return true;
+
+            default:
+                return false;
+        }
+    }
+}
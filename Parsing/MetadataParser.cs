@@ -0,0 +1,84 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+namespace DialScript.Parsing;
+
+// Splits line metadata like "{Emotion: happy, Choice: 1}" into key/value pairs
+// without allocating, so hot paths (stats, validation) can walk it per line
+public ref struct MetadataParser
+{
+    private ReadOnlySpan<char> _remaining;
+    
+    public MetadataParser(ReadOnlySpan<char> metadata)
+    {
+        metadata = metadata.Trim();
+        if (metadata.Length > 0 && metadata[0] == '{')
+        {
+            metadata = metadata[1..];
+        }
+        if (metadata.Length > 0 && metadata[^1] == '}')
+        {
+            metadata = metadata[..^1];
+        }
+        
+        _remaining = metadata;
+        Key = default;
+        Value = default;
+    }
+    
+    public ReadOnlySpan<char> Key { get; private set; }
+    
+    public ReadOnlySpan<char> Value { get; private set; }
+    
+    public MetadataParser GetEnumerator() => this;
+    
+    public MetadataParser Current => this;
+    
+    public bool MoveNext()
+    {
+        while (!_remaining.IsEmpty)
+        {
+            // Entries are separated by ',', but values like "Choices: 1, 2" may contain commas too,
+            // so a segment without ':' belongs to the previous value
+            var end = NextEntryEnd(_remaining);
+            var entry = _remaining[..end];
+            _remaining = end < _remaining.Length ? _remaining[(end + 1)..] : ReadOnlySpan<char>.Empty;
+            
+            var colon = entry.IndexOf(':');
+            if (colon < 0)
+            {
+                continue;
+            }
+            
+            Key = entry[..colon].Trim();
+            Value = entry[(colon + 1)..].Trim();
+            return true;
+        }
+        
+        return false;
+    }
+    
+    private static int NextEntryEnd(ReadOnlySpan<char> span)
+    {
+        var comma = span.IndexOf(',');
+        while (comma >= 0)
+        {
+            var rest = span[(comma + 1)..];
+            var nextComma = rest.IndexOf(',');
+            var segment = nextComma < 0 ? rest : rest[..nextComma];
+            if (segment.Contains(':'))
+            {
+                return comma;
+            }
+            
+            if (nextComma < 0)
+            {
+                return span.Length;
+            }
+            comma += nextComma + 1;
+        }
+        
+        return span.Length;
+    }
+}
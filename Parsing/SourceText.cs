@@ -0,0 +1,83 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Text;
+using System.Text.Unicode;
+
+namespace DialScript.Parsing;
+
+// Lines of a source file together with their byte offsets. Splits like File.ReadAllLines
+// ('\n', '\r' or "\r\n"), but keeps track of where every line starts in the file
+public sealed class SourceText
+{
+    private SourceText(string[] lines, LineIndex lineIndex)
+    {
+        Lines = lines;
+        LineIndex = lineIndex;
+    }
+    
+    public string[] Lines { get; }
+    
+    public LineIndex LineIndex { get; }
+    
+    public static SourceText Load(string path)
+    {
+        return FromBytes(File.ReadAllBytes(path));
+    }
+    
+    public static async Task<SourceText> LoadAsync(string path, CancellationToken cancellationToken = default)
+    {
+        return FromBytes(await File.ReadAllBytesAsync(path, cancellationToken));
+    }
+    
+    public static SourceText FromStream(Stream stream)
+    {
+        using var buffer = new MemoryStream();
+        stream.CopyTo(buffer);
+        return FromBytes(buffer.GetBuffer().AsSpan(0, (int)buffer.Length));
+    }
+    
+    public static SourceText FromLines(string[] lines)
+    {
+        return new SourceText(lines, LineIndex.FromLines(lines));
+    }
+    
+    public static SourceText FromBytes(ReadOnlySpan<byte> bytes)
+    {
+        // UTF-16/32 files: decode like File.ReadAllLines does, offsets are then UTF-8 based
+        if (bytes is [0xFF, 0xFE, ..] or [0xFE, 0xFF, ..])
+        {
+            using var reader = new StreamReader(new MemoryStream(bytes.ToArray()), Encoding.UTF8, true);
+            var decoded = new List<string>();
+            while (reader.ReadLine() is { } decodedLine)
+            {
+                decoded.Add(decodedLine);
+            }
+            return FromLines(decoded.ToArray());
+        }
+        
+        var start = bytes.StartsWith(Encoding.UTF8.Preamble) ? Encoding.UTF8.Preamble.Length : 0;
+        var lines = new List<string>();
+        var lineStarts = new List<int>();
+        
+        while (start < bytes.Length)
+        {
+            var rest = bytes[start..];
+            var end = rest.IndexOfAny((byte)'\n', (byte)'\r');
+            if (end < 0)
+            {
+                end = rest.Length;
+            }
+            
+            lineStarts.Add(start);
+            lines.Add(Encoding.UTF8.GetString(rest[..end]));
+            
+            var terminator = end < rest.Length && rest[end] == '\r' && end + 1 < rest.Length && rest[end + 1] == '\n' ? 2 : 1;
+            start += end + terminator;
+        }
+        
+        var lineArray = lines.ToArray();
+        return new SourceText(lineArray, new LineIndex(lineStarts.ToArray(), lineArray, Utf8.IsValid(bytes)));
+    }
+}
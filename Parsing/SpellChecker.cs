@@ -0,0 +1,222 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Collections.Frozen;
+using System.Globalization;
+
+namespace DialScript.Parsing;
+
+// Word list with a precomputed deletion index (SymSpell): every word is indexed under the
+// strings left after deleting up to MaxDistance characters from its prefix, so a misspelled
+// word finds its candidates by looking up its own few deletions instead of trying all edits.
+// Known words cost one hash lookup. Built once, then shared read-only
+public sealed class SpellChecker
+{
+    public const int MaxDistance = 2;
+
+    // Longest word that is checked, longer tokens are left alone
+    public const int MaxWordLength = 48;
+
+    // Only deletions of the first PrefixLength characters are indexed, which keeps the index
+    // small; candidates are checked against the whole word
+    private const int PrefixLength = 7;
+
+    private readonly FrozenDictionary<string, int>.AlternateLookup<ReadOnlySpan<char>> _words;
+    private readonly string[] _spellings;
+    private readonly long[] _counts;
+
+    // (hash of a deletion << 32 | word), sorted
+    private readonly long[] _deletes;
+
+    private SpellChecker(List<(string Word, long Count)> words)
+    {
+        _spellings = words.Select(w => w.Word).ToArray();
+        _counts = words.Select(w => w.Count).ToArray();
+        _words = _spellings
+            .Select((w, i) => KeyValuePair.Create(w, i))
+            .ToFrozenDictionary(StringComparer.OrdinalIgnoreCase)
+            .GetAlternateLookup<ReadOnlySpan<char>>();
+
+        var deletes = new List<long>();
+        var hashes = new HashSet<int>();
+        Span<char> buffer = stackalloc char[PrefixLength];
+        for (var id = 0; id < _spellings.Length; id++)
+        {
+            var word = _spellings[id].AsSpan();
+            var prefix = buffer[..Math.Min(word.Length, PrefixLength)];
+            word[..prefix.Length].ToLowerInvariant(prefix);
+
+            hashes.Clear();
+            AddDeletions(prefix, MaxDistance, hashes);
+            foreach (var hash in hashes)
+            {
+                deletes.Add(((long)hash << 32) | (uint)id);
+            }
+        }
+
+        _deletes = deletes.ToArray();
+        Array.Sort(_deletes);
+    }
+
+    public bool Contains(ReadOnlySpan<char> word) => _words.ContainsKey(word);
+
+    // Known words closest to the word, nearest first and then most frequent ones.
+    // Only runs for unknown words, so it doesn't bother to avoid allocations
+    public List<string> Suggest(ReadOnlySpan<char> word, int count = 3)
+    {
+        var suggestions = new List<string>();
+        if (word.Length > MaxWordLength)
+        {
+            return suggestions;
+        }
+
+        Span<char> lower = stackalloc char[word.Length];
+        word.ToLowerInvariant(lower);
+
+        var hashes = new HashSet<int>();
+        AddDeletions(lower[..Math.Min(lower.Length, PrefixLength)], MaxDistance, hashes);
+
+        var candidates = new List<(int Distance, long Count, int Word)>();
+        var seen = new HashSet<int>();
+        foreach (var hash in hashes)
+        {
+            // The index is sorted by hash, so all words of a deletion are in one run
+            var index = Array.BinarySearch(_deletes, (long)hash << 32);
+            for (index = index < 0 ? ~index : index; index < _deletes.Length && (int)(_deletes[index] >> 32) == hash; index++)
+            {
+                var id = (int)_deletes[index];
+                if (seen.Add(id))
+                {
+                    var distance = Distance(lower, _spellings[id], MaxDistance);
+                    if (distance <= MaxDistance)
+                    {
+                        candidates.Add((distance, _counts[id], id));
+                    }
+                }
+            }
+        }
+
+        candidates.Sort((a, b) => a.Distance != b.Distance ? a.Distance.CompareTo(b.Distance) : b.Count.CompareTo(a.Count));
+        for (var i = 0; i < candidates.Count && i < count; i++)
+        {
+            suggestions.Add(_spellings[candidates[i].Word]);
+        }
+        return suggestions;
+    }
+
+    // Hashes of the word and of everything left after deleting up to distance characters from it
+    private static void AddDeletions(ReadOnlySpan<char> word, int distance, HashSet<int> hashes)
+    {
+        if (!hashes.Add(string.GetHashCode(word)) && distance < MaxDistance)
+        {
+            return;
+        }
+        if (distance == 0 || word.Length <= 1)
+        {
+            return;
+        }
+
+        Span<char> shorter = stackalloc char[word.Length - 1];
+        for (var i = 0; i < word.Length; i++)
+        {
+            word[..i].CopyTo(shorter);
+            word[(i + 1)..].CopyTo(shorter[i..]);
+            AddDeletions(shorter, distance - 1, hashes);
+        }
+    }
+
+    // Edit distance with adjacent transpositions (optimal string alignment), or max + 1 when
+    // it is larger than max. The word is lower case already
+    private static int Distance(ReadOnlySpan<char> word, string candidate, int max)
+    {
+        if (Math.Abs(word.Length - candidate.Length) > max)
+        {
+            return max + 1;
+        }
+
+        var columns = candidate.Length + 1;
+        Span<int> rows = stackalloc int[columns * 3];
+        var previous2 = rows[..columns];
+        var previous = rows.Slice(columns, columns);
+        var current = rows.Slice(columns * 2, columns);
+        for (var j = 0; j < columns; j++)
+        {
+            previous[j] = j;
+        }
+
+        for (var i = 1; i <= word.Length; i++)
+        {
+            current[0] = i;
+            var rowMin = i;
+            for (var j = 1; j < columns; j++)
+            {
+                var c = char.ToLowerInvariant(candidate[j - 1]);
+                var cost = word[i - 1] == c ? 0 : 1;
+                var value = Math.Min(Math.Min(previous[j] + 1, current[j - 1] + 1), previous[j - 1] + cost);
+                if (i > 1 && j > 1 && word[i - 1] == char.ToLowerInvariant(candidate[j - 2]) && word[i - 2] == c)
+                {
+                    value = Math.Min(value, previous2[j - 2] + 1);
+                }
+                current[j] = value;
+                rowMin = Math.Min(rowMin, value);
+            }
+
+            if (rowMin > max)
+            {
+                return max + 1;
+            }
+
+            var recycled = previous2;
+            previous2 = previous;
+            previous = current;
+            current = recycled;
+        }
+
+        return previous[columns - 1];
+    }
+
+    // Word list: one word per line, optionally followed by its frequency ('the 23135851162'),
+    // as in the usual frequency dictionaries. Allowed terms are added as words of their own
+    public static bool TryLoad(string path, string? allowPath, out SpellChecker? checker, out string? error)
+    {
+        checker = null;
+        error = null;
+        var words = new List<(string Word, long Count)>();
+        var known = new HashSet<string>(StringComparer.OrdinalIgnoreCase);
+
+        foreach (var (file, isAllowList) in new[] { (path, false), (allowPath, true) })
+        {
+            if (file == null)
+            {
+                continue;
+            }
+            if (!File.Exists(file))
+            {
+                error = $"cannot open {(isAllowList ? "allowlist" : "dictionary")} {file}. Does it exist?";
+                return false;
+            }
+
+            foreach (var line in File.ReadLines(file))
+            {
+                var entry = line.Trim();
+                if (entry.Length == 0 || entry.StartsWith("//"))
+                {
+                    continue;
+                }
+
+                var separator = entry.IndexOfAny([' ', '\t']);
+                var word = separator < 0 ? entry : entry[..separator];
+                long.TryParse(separator < 0 ? "" : entry[(separator + 1)..].Trim(), NumberStyles.Integer, 
+                    CultureInfo.InvariantCulture, out var count);
+                if (word.Length <= MaxWordLength && known.Add(word))
+                {
+                    words.Add((word, count));
+                }
+            }
+        }
+
+        checker = new SpellChecker(words);
+        return true;
+    }
+}
@@ -0,0 +1,272 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Buffers;
+
+namespace DialScript.Parsing;
+
+public readonly record struct TermMatch(int Start, int Length, string Term);
+
+// Finds all terms of a list in one pass over the text (Aho-Corasick), case-insensitively, e.g.
+//
+//     // Banned terms
+//     damn
+//     hell*
+//     *shit*
+//
+// Terms match whole words, a '*' lets the word go on at that side ('hell*' matches 'hellish').
+// Words aren't separated in CJK text, so terms there match anywhere. Built once, then shared read-only
+public sealed class TermMatcher
+{
+    [Flags]
+    private enum TermFlags
+    {
+        None = 0,
+        AnyStart = 1,                // '*term': letters may come before
+        AnyEnd = 2                   // 'term*': letters may come after
+    }
+
+    // Transitions of state s are _labels/_targets[_first[s].._first[s + 1]], sorted by label
+    private readonly int[] _first;
+    private readonly char[] _labels;
+    private readonly int[] _targets;
+
+    private readonly int[] _fail;
+
+    // Term ending in a state (-1 = none), and the next state down the fail chain that ends one
+    private readonly int[] _output;
+    private readonly int[] _outputLink;
+
+    private readonly string[] _terms;
+    private readonly int[] _lengths;
+    private readonly TermFlags[] _flags;
+
+    // Characters a term can start with, in every case. Text is skipped with a vectorized
+    // search while the automaton is at the root
+    private readonly SearchValues<char> _firstChars;
+
+    private TermMatcher(List<Dictionary<char, int>> trie, int[] fail, int[] output, int[] outputLink,
+        List<(string Term, TermFlags Flags)> terms, SearchValues<char> firstChars)
+    {
+        _first = new int[trie.Count + 1];
+        _labels = new char[trie.Count - 1];
+        _targets = new int[trie.Count - 1];
+        var next = 0;
+        for (var state = 0; state < trie.Count; state++)
+        {
+            _first[state] = next;
+            foreach (var (label, target) in trie[state].OrderBy(t => t.Key))
+            {
+                _labels[next] = label;
+                _targets[next++] = target;
+            }
+        }
+        _first[trie.Count] = next;
+
+        _fail = fail;
+        _output = output;
+        _outputLink = outputLink;
+        _terms = terms.Select(t => t.Term).ToArray();
+        _lengths = _terms.Select(t => t.Length).ToArray();
+        _flags = terms.Select(t => t.Flags).ToArray();
+        _firstChars = firstChars;
+    }
+
+    public static TermMatcher Build(IEnumerable<string> entries)
+    {
+        var trie = new List<Dictionary<char, int>> { new() };
+        var output = new List<int> { -1 };
+        var terms = new List<(string Term, TermFlags Flags)>();
+
+        foreach (var entry in entries)
+        {
+            var flags = TermFlags.None;
+            var term = entry;
+            if (term.StartsWith('*'))
+            {
+                flags |= TermFlags.AnyStart;
+                term = term[1..];
+            }
+            if (term.EndsWith('*'))
+            {
+                flags |= TermFlags.AnyEnd;
+                term = term[..^1];
+            }
+            if (term.Length == 0)
+            {
+                continue;
+            }
+
+            var state = 0;
+            foreach (var c in term)
+            {
+                var folded = char.ToLowerInvariant(c);
+                if (!trie[state].TryGetValue(folded, out var target))
+                {
+                    target = trie.Count;
+                    trie[state].Add(folded, target);
+                    trie.Add(new Dictionary<char, int>());
+                    output.Add(-1);
+                }
+                state = target;
+            }
+
+            // A term listed twice keeps its first spelling
+            if (output[state] < 0)
+            {
+                output[state] = terms.Count;
+                terms.Add((term, flags));
+            }
+        }
+
+        // Fail links breadth-first: the longest proper suffix of a state that is also a prefix
+        var fail = new int[trie.Count];
+        var outputLink = new int[trie.Count];
+        outputLink[0] = -1;
+        var queue = new Queue<int>();
+        foreach (var target in trie[0].Values)
+        {
+            outputLink[target] = -1;
+            queue.Enqueue(target);
+        }
+
+        while (queue.TryDequeue(out var state))
+        {
+            foreach (var (label, target) in trie[state])
+            {
+                var fallback = fail[state];
+                while (fallback != 0 && !trie[fallback].ContainsKey(label))
+                {
+                    fallback = fail[fallback];
+                }
+                fail[target] = trie[fallback].TryGetValue(label, out var suffix) && suffix != target ? suffix : 0;
+                outputLink[target] = output[fail[target]] >= 0 ? fail[target] : outputLink[fail[target]];
+                queue.Enqueue(target);
+            }
+        }
+
+        // Every character whose lower case starts a term
+        var firstChars = new List<char>();
+        for (var c = 0; c <= char.MaxValue; c++)
+        {
+            if (trie[0].ContainsKey(char.ToLowerInvariant((char)c)))
+            {
+                firstChars.Add((char)c);
+            }
+        }
+
+        return new TermMatcher(trie, fail, output.ToArray(), outputLink, terms, SearchValues.Create(firstChars.ToArray()));
+    }
+
+    public Matches Find(ReadOnlySpan<char> text) => new(this, text);
+
+    private int Step(int state, char c)
+    {
+        while (true)
+        {
+            var transitions = _labels.AsSpan(_first[state], _first[state + 1] - _first[state]);
+            var index = transitions.BinarySearch(c);
+            if (index >= 0)
+            {
+                return _targets[_first[state] + index];
+            }
+            if (state == 0)
+            {
+                return 0;
+            }
+            state = _fail[state];
+        }
+    }
+
+    private bool IsWholeMatch(ReadOnlySpan<char> text, int start, int end, int term)
+    {
+        var flags = _flags[term];
+        return (flags.HasFlag(TermFlags.AnyStart) || start == 0 || !IsWordBoundaryNeeded(text[start - 1], text[start])) &&
+               (flags.HasFlag(TermFlags.AnyEnd) || end == text.Length || !IsWordBoundaryNeeded(text[end - 1], text[end]));
+    }
+
+    // Letters or digits on both sides of the edge, outside of CJK text
+    private static bool IsWordBoundaryNeeded(char left, char right)
+    {
+        return char.IsLetterOrDigit(left) && char.IsLetterOrDigit(right) && left < '\u2E80' && right < '\u2E80';
+    }
+
+    // Matches in the order they end, overlapping ones included
+    public ref struct Matches
+    {
+        private readonly TermMatcher _matcher;
+        private readonly ReadOnlySpan<char> _text;
+        private int _position;
+        private int _state;
+        private int _pending = -1;
+
+        internal Matches(TermMatcher matcher, ReadOnlySpan<char> text)
+        {
+            _matcher = matcher;
+            _text = text;
+        }
+
+        public TermMatch Current { get; private set; }
+
+        public readonly Matches GetEnumerator() => this;
+
+        public bool MoveNext()
+        {
+            var matcher = _matcher;
+            while (true)
+            {
+                // Terms ending at the current position, longest first
+                while (_pending >= 0)
+                {
+                    var term = matcher._output[_pending];
+                    _pending = matcher._outputLink[_pending];
+
+                    var start = _position - matcher._lengths[term];
+                    if (matcher.IsWholeMatch(_text, start, _position, term))
+                    {
+                        Current = new TermMatch(start, matcher._lengths[term], matcher._terms[term]);
+                        return true;
+                    }
+                }
+
+                if (_position >= _text.Length)
+                {
+                    return false;
+                }
+
+                if (_state == 0)
+                {
+                    var skip = _text[_position..].IndexOfAny(matcher._firstChars);
+                    if (skip < 0)
+                    {
+                        _position = _text.Length;
+                        return false;
+                    }
+                    _position += skip;
+                }
+
+                _state = matcher.Step(_state, char.ToLowerInvariant(_text[_position++]));
+                _pending = matcher._output[_state] >= 0 ? _state : matcher._outputLink[_state];
+            }
+        }
+    }
+
+    public static bool TryLoad(string path, out TermMatcher? matcher, out string? error)
+    {
+        matcher = null;
+        error = null;
+        if (!File.Exists(path))
+        {
+            error = $"cannot open term list {path}. Does it exist?";
+            return false;
+        }
+
+        // One term per line, empty lines and '//' comments are skipped
+        var terms = File.ReadLines(path)
+            .Select(l => l.Trim())
+            .Where(l => l.Length > 0 && !l.StartsWith("//"));
+        matcher = Build(terms);
+        return true;
+    }
+}
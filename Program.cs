@@ -1,5 +1,10 @@
-﻿using DialScript.Compiler;
+﻿using DialScript.Analysis;
+using DialScript.Compiler;
+using DialScript.Export;
+using DialScript.Formatting;
 using DialScript.Output;
+using DialScript.Parsing;
+using DialScript.Schema;
 
 namespace DialScript;
 
@@ -16,18 +21,182 @@ public class Program
             return 0;
         }
         
+        // Subcommands
+        if (args[0] == "stats")
+        {
+            return RunStats(args[1..]);
+        }
+        
+        if (args[0] == "fmt")
+        {
+            return RunFormat(args[1..]);
+        }
+        
+        if (args[0] == "check")
+        {
+            return RunCheck(args[1..]);
+        }
+        
+        return RunCompile(args);
+    }
+    
+    // changedFiles is set by 'check' and always goes through the pipeline, even for zero or one file
+    private static int RunCompile(string[] args, List<string>? changedFiles = null)
+    {
+        // Expand @file.rsp response files
+        if (!TryExpandResponseFiles(args, out args))
+        {
+            return 1;
+        }
+        
         // Parse arguments
         var settings = new CompilerSettings();
-        string? filename = null;
+        var pipelineSettings = new PipelineSettings();
+        var inputs = new List<string>();
+        string? filesFrom = null;
+        string? dictionaryPath = null;
+        string? allowPath = null;
         
-        foreach (var arg in args)
+        for (var i = 0; i < args.Length; i++)
         {
+            var arg = args[i];
             switch (arg)
             {
                 case "--verbose" or "-v":
                     settings.Verbose = true;
                     break;
                     
+                case "--quiet" or "-q":
+                    settings.Quiet = true;
+                    break;
+                    
+                case "--max-errors":
+                    if (!TryReadCount(args, ref i, out var maxErrors))
+                    {
+                        return 1;
+                    }
+                    settings.MaxErrors = maxErrors;
+                    break;
+                    
+                case "--collapse":
+                    settings.CollapseErrors = true;
+                    break;
+                    
+                case "--fix":
+                    settings.ApplyFixes = true;
+                    break;
+                    
+                case "--max-line-length":
+                    if (!TryReadCount(args, ref i, out var maxLineLength))
+                    {
+                        return 1;
+                    }
+                    settings.MaxLineLength = maxLineLength;
+                    break;
+                    
+                case "--schema":
+                    if (!TryReadValue(args, ref i, out var schemaPath))
+                    {
+                        return 1;
+                    }
+                    if (!MetadataSchema.TryLoad(schemaPath, out var schema, out var schemaError))
+                    {
+                        ConsoleOutput.PrintErrorMessage(schemaError!);
+                        return 1;
+                    }
+                    settings.Schema = schema;
+                    break;
+                    
+                case "--banned":
+                    if (!TryReadValue(args, ref i, out var bannedPath))
+                    {
+                        return 1;
+                    }
+                    if (!TermMatcher.TryLoad(bannedPath, out var bannedTerms, out var bannedError))
+                    {
+                        ConsoleOutput.PrintErrorMessage(bannedError!);
+                        return 1;
+                    }
+                    settings.BannedTerms = bannedTerms;
+                    break;
+                    
+                case "--dictionary":
+                    if (!TryReadValue(args, ref i, out dictionaryPath))
+                    {
+                        return 1;
+                    }
+                    break;
+                    
+                case "--allow":
+                    if (!TryReadValue(args, ref i, out allowPath))
+                    {
+                        return 1;
+                    }
+                    break;
+                    
+                case "--layout":
+                    if (!TryReadValue(args, ref i, out var layoutPath))
+                    {
+                        return 1;
+                    }
+                    if (!TextLayout.TryLoad(layoutPath, out var layout, out var layoutError))
+                    {
+                        ConsoleOutput.PrintErrorMessage(layoutError!);
+                        return 1;
+                    }
+                    settings.Layout = layout;
+                    break;
+                    
+                case "--emit":
+                    if (!TryReadValue(args, ref i, out var target))
+                    {
+                        return 1;
+                    }
+                    switch (target)
+                    {
+                        case "graph":
+                            settings.Emit |= EmitTarget.Graph;
+                            break;
+                            
+                        case "html":
+                            settings.Emit |= EmitTarget.Html;
+                            break;
+                            
+                        case "md":
+                            settings.Emit |= EmitTarget.Markdown;
+                            break;
+                            
+                        case "text":
+                            settings.Emit |= EmitTarget.Text;
+                            break;
+                            
+                        default:
+                            ConsoleOutput.PrintErrorMessage($"unknown --emit target '{target}', use graph, html, md or text");
+                            return 1;
+                    }
+                    break;
+                    
+                case "--graph-format":
+                    if (!TryReadValue(args, ref i, out var graphFormat))
+                    {
+                        return 1;
+                    }
+                    switch (graphFormat)
+                    {
+                        case "dot":
+                            settings.GraphFormat = GraphFormat.Dot;
+                            break;
+                            
+                        case "graphml":
+                            settings.GraphFormat = GraphFormat.GraphMl;
+                            break;
+                            
+                        default:
+                            ConsoleOutput.PrintErrorMessage($"unknown graph format '{graphFormat}', use dot or graphml");
+                            return 1;
+                    }
+                    break;
+                    
                 case "--help" or "-h":
                     ConsoleOutput.PrintHelp(Version);
                     return 0;
@@ -40,6 +209,31 @@ public class Program
                     ConsoleOutput.PrintExample();
                     return 0;
                     
+                case "--jobs" or "-j":
+                    if (!TryReadCount(args, ref i, out var jobs))
+                    {
+                        return 1;
+                    }
+                    pipelineSettings.Parsers = jobs;
+                    pipelineSettings.Validators = jobs;
+                    break;
+                    
+                case "--stream":
+                    pipelineSettings.Order = DiagnosticOrder.Streaming;
+                    break;
+                    
+                case "--files-from":
+                    if (!TryReadValue(args, ref i, out var listPath))
+                    {
+                        return 1;
+                    }
+                    filesFrom = listPath;
+                    break;
+                    
+                case "-":
+                    inputs.Add(arg);
+                    break;
+                    
                 default:
                     if (arg.StartsWith('-'))
                     {
@@ -47,18 +241,114 @@ public class Program
                         Console.WriteLine("Use 'dialscript --help' for usage information");
                         return 1;
                     }
-                    filename = arg;
+                    inputs.Add(arg);
                     break;
             }
         }
         
-        // Check that filename was specified
-        if (string.IsNullOrEmpty(filename))
+        // Word list and allowlist, in whatever order they were given
+        if (allowPath != null && dictionaryPath == null)
+        {
+            ConsoleOutput.PrintErrorMessage("--allow needs a --dictionary");
+            return 1;
+        }
+        if (dictionaryPath != null)
+        {
+            if (!SpellChecker.TryLoad(dictionaryPath, allowPath, out var spelling, out var spellingError))
+            {
+                ConsoleOutput.PrintErrorMessage(spellingError!);
+                return 1;
+            }
+            settings.Spelling = spelling;
+        }
+        
+        // File list from a file or stdin
+        if (filesFrom != null)
+        {
+            if (filesFrom != "-" && !File.Exists(filesFrom))
+            {
+                ConsoleOutput.PrintErrorMessage($"cannot open file list {filesFrom}. Does it exist?");
+                return 1;
+            }
+            
+            using var reader = filesFrom == "-" ? Console.In : new StreamReader(filesFrom);
+            inputs.AddRange(ReadList(reader));
+        }
+        
+        // Files reported by git
+        if (changedFiles != null)
+        {
+            if (inputs.Count > 0 || filesFrom != null)
+            {
+                ConsoleOutput.PrintErrorMessage("'check' takes its files from git and no other inputs");
+                return 1;
+            }
+            
+            var pipeline = new CompilePipeline(settings, pipelineSettings);
+            var summary = pipeline.RunAsync(changedFiles).GetAwaiter().GetResult();
+            ConsoleOutput.PrintSummary(summary);
+            return ExitCode(summary.Errors);
+        }
+        
+        // Check that an input was specified
+        if (inputs.Count == 0)
         {
             ConsoleOutput.PrintErrorMessage("no input file specified");
             return 1;
         }
         
+        // Script from stdin
+        if (inputs.Contains("-"))
+        {
+            if (inputs.Count > 1 || filesFrom == "-")
+            {
+                ConsoleOutput.PrintErrorMessage("'-' reads one script from stdin and can't be combined with other inputs");
+                return 1;
+            }
+            if (settings.ApplyFixes)
+            {
+                ConsoleOutput.PrintErrorMessage("--fix can't rewrite stdin");
+                return 1;
+            }
+            if (settings.Emit != EmitTarget.None)
+            {
+                ConsoleOutput.PrintErrorMessage("--emit writes next to the script and can't be used with stdin");
+                return 1;
+            }
+            
+            var source = SourceText.FromStream(Console.OpenStandardInput());
+            return ExitCode(new DialScriptCompiler(settings).Compile("<stdin>", source).ErrorCount);
+        }
+        
+        // Compile directories and file lists
+        if (inputs.Count > 1 || Directory.Exists(inputs[0]))
+        {
+            var files = new List<string>();
+            foreach (var input in inputs)
+            {
+                if (Directory.Exists(input))
+                {
+                    files.AddRange(FindSourceFiles(input));
+                }
+                else if (input.EndsWith(".ds"))
+                {
+                    files.Add(input);
+                }
+                else
+                {
+                    ConsoleOutput.PrintErrorMessage($"only .ds files are supported: {input}");
+                    return 1;
+                }
+            }
+            
+            var pipeline = new CompilePipeline(settings, pipelineSettings);
+            var summary = pipeline.RunAsync(files).GetAwaiter().GetResult();
+            ConsoleOutput.PrintSummary(summary);
+            return ExitCode(summary.Errors);
+        }
+        
+        var filename = inputs[0];
+        
         // Check for .ds extension
         if (!filename.EndsWith(".ds"))
         {
@@ -68,9 +358,183 @@ public class Program
         
         // Compile
         var compiler = new DialScriptCompiler(settings);
-        var result = compiler.Compile(filename);
+        using var result = compiler.Compile(filename);
+        FixWriter.Apply(filename, result.Fixes);
+        var failed = ScriptExport.Write(result, settings);
+        if (!settings.Quiet)
+        {
+            for (var i = result.Errors.Count - failed; i < result.Errors.Count; i++)
+            {
+                ConsoleOutput.PrintError(result.Errors[i]);
+            }
+        }
         
         // Return error count as exit code
-        return result.Errors.Count;
+        return ExitCode(result.ErrorCount);
+    }
+    
+    private static int RunStats(string[] args)
+    {
+        if (args.Length != 1)
+        {
+            ConsoleOutput.PrintErrorMessage("usage: dialscript stats <directory>");
+            return 1;
+        }
+        
+        var path = args[0];
+        string root;
+        List<string> files;
+        
+        if (Directory.Exists(path))
+        {
+            root = path;
+            files = FindSourceFiles(path);
+        }
+        else if (File.Exists(path) && path.EndsWith(".ds"))
+        {
+            root = Path.GetDirectoryName(Path.GetFullPath(path)) ?? ".";
+            files = [path];
+        }
+        else
+        {
+            ConsoleOutput.PrintErrorMessage($"cannot open {path}. Does it exist?");
+            return 1;
+        }
+        
+        var stats = StatsCollector.Collect(files, root);
+        ConsoleOutput.PrintStats(stats);
+        return 0;
+    }
+    
+    private static int RunFormat(string[] args)
+    {
+        if (args.Length == 0)
+        {
+            ConsoleOutput.PrintErrorMessage("usage: dialscript fmt <filename.ds|directory>...");
+            return 1;
+        }
+        
+        var files = new List<string>();
+        foreach (var path in args)
+        {
+            if (Directory.Exists(path))
+            {
+                files.AddRange(FindSourceFiles(path));
+            }
+            else if (File.Exists(path) && path.EndsWith(".ds"))
+            {
+                files.Add(path);
+            }
+            else
+            {
+                ConsoleOutput.PrintErrorMessage($"cannot open {path}. Does it exist?");
+                return 1;
+            }
+        }
+        
+        var results = ScriptFormatter.FormatFiles(files);
+        ConsoleOutput.PrintFormatted(files, results);
+        return results.Contains(FormatResult.NotUtf8) ? 1 : 0;
+    }
+    
+    // Exit codes are a byte on Unix, 256 errors would wrap around to success
+    private static int ExitCode(int errors) => Math.Min(errors, 255);
+    
+    private static int RunCheck(string[] args)
+    {
+        var sinceIndex = Array.IndexOf(args, "--since");
+        if (sinceIndex < 0 || sinceIndex + 1 >= args.Length)
+        {
+            ConsoleOutput.PrintErrorMessage("usage: dialscript check --since <rev> [options]");
+            return 1;
+        }
+        
+        if (!GitChanges.TryGetChangedFiles(args[sinceIndex + 1], out var files))
+        {
+            return 1;
+        }
+        
+        // The remaining arguments are regular compile options
+        var options = args[..sinceIndex].Concat(args[(sinceIndex + 2)..]).ToArray();
+        return RunCompile(options, files);
+    }
+    
+    // Replaces every @file argument with the arguments listed in that file, one per line
+    private static bool TryExpandResponseFiles(string[] args, out string[] expanded)
+    {
+        expanded = args;
+        if (!args.Any(a => a.StartsWith('@')))
+        {
+            return true;
+        }
+        
+        var result = new List<string>(args.Length);
+        foreach (var arg in args)
+        {
+            if (!arg.StartsWith('@'))
+            {
+                result.Add(arg);
+                continue;
+            }
+            
+            var path = arg[1..];
+            if (!File.Exists(path))
+            {
+                ConsoleOutput.PrintErrorMessage($"cannot open response file {path}. Does it exist?");
+                return false;
+            }
+            
+            using var reader = new StreamReader(path);
+            result.AddRange(ReadList(reader));
+        }
+        
+        expanded = result.ToArray();
+        return true;
+    }
+    
+    // One entry per line, empty lines and '#' comments are skipped
+    private static IEnumerable<string> ReadList(TextReader reader)
+    {
+        while (reader.ReadLine() is { } line)
+        {
+            var entry = line.Trim();
+            if (entry.Length > 0 && !entry.StartsWith('#'))
+            {
+                yield return entry;
+            }
+        }
+    }
+    
+    private static List<string> FindSourceFiles(string directory)
+    {
+        var files = Directory.EnumerateFiles(directory, "*.ds", SearchOption.AllDirectories).ToList();
+        files.Sort(StringComparer.Ordinal);
+        return files;
+    }
+    
+    private static bool TryReadValue(string[] args, ref int index, out string value)
+    {
+        value = string.Empty;
+        if (index + 1 >= args.Length)
+        {
+            ConsoleOutput.PrintErrorMessage($"option '{args[index]}' expects a value");
+            return false;
+        }
+        
+        value = args[++index];
+        return true;
+    }
+    
+    private static bool TryReadCount(string[] args, ref int index, out int value)
+    {
+        value = 0;
+        if (index + 1 >= args.Length || !int.TryParse(args[index + 1], out value) || value <= 0)
+        {
+            ConsoleOutput.PrintErrorMessage($"option '{args[index]}' expects a positive number");
+            return false;
+        }
+        
+        index++;
+        return true;
     }
 }
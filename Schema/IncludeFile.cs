@@ -0,0 +1,111 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Collections.Concurrent;
+using System.Collections.Frozen;
+using System.Text.RegularExpressions;
+
+namespace DialScript.Schema;
+
+// Shared definitions pulled into a scene with 'Include: path', e.g.
+//
+//     // Main cast
+//     Characters: Alan, Beth
+//     Characters: Narrator
+//
+//     // Metadata schema, same format as --schema
+//     Emotion: {happy, surprised, thinking, grateful}
+//
+// Immutable after loading, so one instance is shared by every file and worker
+public sealed partial class IncludeFile
+{
+    [GeneratedRegex(@"^Characters:\s*(.*)$", RegexOptions.IgnoreCase)]
+    private static partial Regex CharactersPattern();
+
+    private IncludeFile(string path, FrozenSet<string> characters, MetadataSchema? schema)
+    {
+        Path = path;
+        Characters = characters;
+        Schema = schema;
+    }
+
+    public string Path { get; }
+
+    public FrozenSet<string> Characters { get; }
+
+    // Null when the file declares no metadata keys
+    public MetadataSchema? Schema { get; }
+
+    public static bool TryLoad(string path, out IncludeFile? include, out string? error)
+    {
+        include = null;
+        if (!File.Exists(path))
+        {
+            error = $"cannot open {path}";
+            return false;
+        }
+
+        var lines = File.ReadAllLines(path);
+        var characters = new HashSet<string>(StringComparer.Ordinal);
+        var hasSchema = false;
+
+        for (var i = 0; i < lines.Length; i++)
+        {
+            var match = CharactersPattern().Match(lines[i].Trim());
+            if (match.Success)
+            {
+                characters.UnionWith(match.Groups[1].Value
+                    .Split(',', StringSplitOptions.TrimEntries | StringSplitOptions.RemoveEmptyEntries));
+
+                // Blank instead of removing, so schema errors keep their line numbers
+                lines[i] = string.Empty;
+            }
+            else if (lines[i].Trim() is { Length: > 0 } line && !line.StartsWith("//"))
+            {
+                hasSchema = true;
+            }
+        }
+
+        MetadataSchema? schema = null;
+        if (hasSchema && !MetadataSchema.TryParse(lines, out schema, out error, path))
+        {
+            return false;
+        }
+
+        error = null;
+        include = new IncludeFile(path, characters.ToFrozenSet(StringComparer.Ordinal), schema);
+        return true;
+    }
+}
+
+// Include files loaded during one run, keyed by full path. Each file is read and parsed once,
+// even when many workers ask for it at the same time
+public sealed class IncludeCache
+{
+    private readonly ConcurrentDictionary<string, Lazy<(IncludeFile? Include, string? Error)>> _files =
+        new(StringComparer.Ordinal);
+
+    // Schemas merged for includes, keyed by the schema so far (--schema or an earlier merge,
+    // both shared instances) and the include path. Every script with the same includes gets one instance
+    private readonly ConcurrentDictionary<(MetadataSchema Schema, string Path), Lazy<(MetadataSchema? Merged, string? Conflict)>> _merged = new();
+
+    public bool TryGet(string path, out IncludeFile? include, out string? error)
+    {
+        var fullPath = System.IO.Path.GetFullPath(path);
+        var entry = _files.GetOrAdd(fullPath, p => new Lazy<(IncludeFile?, string?)>(() =>
+            IncludeFile.TryLoad(p, out var loaded, out var loadError) ? (loaded, null) : (null, loadError)));
+
+        (include, error) = entry.Value;
+        return include != null;
+    }
+
+    public bool TryMerge(MetadataSchema schema, IncludeFile include, out MetadataSchema? merged, out string? conflict)
+    {
+        var entry = _merged.GetOrAdd((schema, include.Path), _ => new Lazy<(MetadataSchema?, string?)>(() =>
+            schema.TryMerge(include.Schema!, out var result, out var key) ? (result, null) : (null, key)));
+
+        (merged, conflict) = entry.Value;
+        return merged != null;
+    }
+}
@@ -0,0 +1,179 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Collections.Frozen;
+using System.Globalization;
+
+namespace DialScript.Schema;
+
+public enum MetadataValueType
+{
+    Text,                        // Any value
+    Number,                      // Integer
+    List,                        // Comma-separated values
+    Enum                         // One of the declared values
+}
+
+public sealed class MetadataField
+{
+    // Looked up by the span of the value, no string is allocated for it
+    private readonly FrozenSet<string>.AlternateLookup<ReadOnlySpan<char>> _allowedValues;
+    
+    public MetadataField(string key, MetadataValueType type, FrozenSet<string>? allowedValues = null)
+    {
+        Key = key;
+        Type = type;
+        AllowedValues = allowedValues;
+        if (allowedValues != null)
+        {
+            _allowedValues = allowedValues.GetAlternateLookup<ReadOnlySpan<char>>();
+        }
+    }
+    
+    public string Key { get; }
+    
+    public MetadataValueType Type { get; }
+    
+    public FrozenSet<string>? AllowedValues { get; }
+    
+    public bool IsValid(ReadOnlySpan<char> value)
+    {
+        return Type switch
+        {
+            MetadataValueType.Number => int.TryParse(value, NumberStyles.Integer, CultureInfo.InvariantCulture, out _),
+            MetadataValueType.Enum => _allowedValues.Contains(value),
+            _ => value.Length > 0
+        };
+    }
+    
+    public bool IsSameAs(MetadataField other)
+    {
+        return Type == other.Type &&
+               (AllowedValues == null ? other.AllowedValues == null : other.AllowedValues != null && AllowedValues.SetEquals(other.AllowedValues));
+    }
+}
+
+// Allowed line metadata keys and values of a project, e.g.
+//
+//     // Project metadata
+//     Emotion: {happy, surprised, thinking, grateful}
+//     Choice: text
+//     Choices: list
+//     Pause: number
+//
+// Keys are matched case-insensitively, enum values exactly. Built once, then shared read-only
+public sealed class MetadataSchema
+{
+    private readonly FrozenDictionary<string, MetadataField>.AlternateLookup<ReadOnlySpan<char>> _fields;
+    
+    private MetadataSchema(IEnumerable<MetadataField> fields)
+    {
+        _fields = fields
+            .ToFrozenDictionary(f => f.Key, StringComparer.OrdinalIgnoreCase)
+            .GetAlternateLookup<ReadOnlySpan<char>>();
+    }
+    
+    public bool TryGetField(ReadOnlySpan<char> key, out MetadataField field)
+    {
+        return _fields.TryGetValue(key, out field);
+    }
+    
+    // Fields of both schemas, or the first key they declare differently in conflict
+    public bool TryMerge(MetadataSchema other, out MetadataSchema? merged, out string? conflict)
+    {
+        merged = null;
+        conflict = null;
+        var fields = new Dictionary<string, MetadataField>(_fields.Dictionary, StringComparer.OrdinalIgnoreCase);
+        foreach (var field in other._fields.Dictionary.Values)
+        {
+            if (fields.TryGetValue(field.Key, out var existing) && !existing.IsSameAs(field))
+            {
+                conflict = field.Key;
+                return false;
+            }
+            fields.TryAdd(field.Key, field);
+        }
+        
+        merged = new MetadataSchema(fields.Values);
+        return true;
+    }
+    
+    public static bool TryLoad(string path, out MetadataSchema? schema, out string? error)
+    {
+        schema = null;
+        if (!File.Exists(path))
+        {
+            error = $"cannot open schema file {path}. Does it exist?";
+            return false;
+        }
+        
+        return TryParse(File.ReadAllLines(path), out schema, out error, path);
+    }
+    
+    public static bool TryParse(string[] lines, out MetadataSchema? schema, out string? error, string source = "schema")
+    {
+        schema = null;
+        error = null;
+        var fields = new Dictionary<string, MetadataField>(StringComparer.OrdinalIgnoreCase);
+        
+        for (var i = 0; i < lines.Length; i++)
+        {
+            var line = lines[i].Trim();
+            if (line.Length == 0 || line.StartsWith("//"))
+            {
+                continue;
+            }
+            
+            var colon = line.IndexOf(':');
+            var key = colon > 0 ? line[..colon].Trim() : string.Empty;
+            var declaration = colon > 0 ? line[(colon + 1)..].Trim() : string.Empty;
+            if (key.Length == 0 || declaration.Length == 0)
+            {
+                error = $"{source}:{i + 1}: expected 'Key: type' or 'Key: {{value1, value2}}'";
+                return false;
+            }
+            
+            if (fields.ContainsKey(key))
+            {
+                error = $"{source}:{i + 1}: duplicate key '{key}'";
+                return false;
+            }
+            
+            MetadataField field;
+            if (declaration.StartsWith('{') && declaration.EndsWith('}'))
+            {
+                var values = declaration[1..^1]
+                    .Split(',', StringSplitOptions.TrimEntries | StringSplitOptions.RemoveEmptyEntries)
+                    .ToFrozenSet(StringComparer.Ordinal);
+                field = new MetadataField(key, MetadataValueType.Enum, values);
+            }
+            else
+            {
+                switch (declaration.ToLowerInvariant())
+                {
+                    case "text":
+                        field = new MetadataField(key, MetadataValueType.Text);
+                        break;
+                        
+                    case "number":
+                        field = new MetadataField(key, MetadataValueType.Number);
+                        break;
+                        
+                    case "list":
+                        field = new MetadataField(key, MetadataValueType.List);
+                        break;
+                        
+                    default:
+                        error = $"{source}:{i + 1}: unknown type '{declaration}', use text, number, list or {{values}}";
+                        return false;
+                }
+            }
+            
+            fields.Add(key, field);
+        }
+        
+        schema = new MetadataSchema(fields.Values);
+        return true;
+    }
+}
@@ -0,0 +1,306 @@
+// Copyright © 2025 Arsenii Motorin
+// Licensed under the Apache License, Version 2.0
+// See: http://www.apache.org/licenses/LICENSE-2.0
+
+using System.Buffers;
+using System.Collections.Frozen;
+using System.Globalization;
+using System.Text;
+using System.Text.Json;
+
+namespace DialScript.Schema;
+
+// Text box of the game and the advance widths of its font (--layout), e.g.
+//
+//     {
+//       "width": 480,                // Box width in font units
+//       "lines": 3,                  // Lines per page
+//       "pages": 1,                  // Pages a dialog line may take (default 1)
+//       "default": 12,               // Width of characters not listed
+//       "glyphs": { " ": 6, "i": 5, "W": 16, "U+4E00-U+9FFF": 24 }
+//     }
+//
+// Glyphs are single characters or code point ranges. Built once, then shared read-only
+public sealed class TextLayout
+{
+    private const int FastCount = 256;
+
+    // Widths of U+0000..U+00FF, everything else is looked up in the tables below
+    private readonly int[] _fast = new int[FastCount];
+    private readonly FrozenDictionary<int, int> _glyphs;
+    private readonly (int First, int Last, int Width)[] _ranges;
+    private readonly int _default;
+
+    private TextLayout(int width, int lines, int pages, int defaultWidth,
+        Dictionary<int, int> glyphs, List<(int First, int Last, int Width)> ranges)
+    {
+        Width = width;
+        LinesPerPage = lines;
+        MaxPages = pages;
+        _default = defaultWidth;
+        _glyphs = glyphs.ToFrozenDictionary();
+        _ranges = ranges.ToArray();
+
+        for (var c = 0; c < FastCount; c++)
+        {
+            _fast[c] = Lookup(c);
+        }
+    }
+
+    public int Width { get; }
+
+    public int LinesPerPage { get; }
+
+    public int MaxPages { get; }
+
+    public int MaxLines => LinesPerPage * MaxPages;
+
+    public int GetWidth(int codePoint)
+    {
+        return codePoint < FastCount ? _fast[codePoint] : Lookup(codePoint);
+    }
+
+    private int Lookup(int codePoint)
+    {
+        if (_glyphs.TryGetValue(codePoint, out var width))
+        {
+            return width;
+        }
+
+        // Later ranges win, so a narrow range can override part of a wide one
+        for (var i = _ranges.Length - 1; i >= 0; i--)
+        {
+            if (codePoint >= _ranges[i].First && codePoint <= _ranges[i].Last)
+            {
+                return _ranges[i].Width;
+            }
+        }
+
+        return _default;
+    }
+
+    // Greedy line breaking of plain dialog text. Lines break after spaces and hyphens and around
+    // CJK characters, except before closing punctuation; a word wider than the box is broken
+    // between grapheme clusters and its offset returned in tooWideAt (-1 if none).
+    // Breaks get the offset of every line start after the first. Returns the number of lines
+    public int Break(ReadOnlySpan<char> text, List<int>? breaks, out int tooWideAt)
+    {
+        tooWideAt = -1;
+        var lines = 1;
+        var lineStart = 0;
+        var lineWidth = 0;
+
+        // Last place the line may break, and the width of the text after it
+        var breakAt = -1;
+        var widthAfterBreak = 0;
+        var previous = default(Rune);
+
+        for (var i = 0; i < text.Length;)
+        {
+            var length = StringInfo.GetNextTextElementLength(text[i..]);
+            Rune.DecodeFromUtf16(text[i..], out var rune, out _);
+
+            // Combining marks and joiners don't advance, a cluster is as wide as its first character
+            var width = GetWidth(rune.Value);
+
+            if (Rune.IsWhiteSpace(rune))
+            {
+                // Spaces may hang past the edge of the box
+                lineWidth += width;
+                breakAt = i + length;
+                widthAfterBreak = 0;
+                previous = rune;
+                i += length;
+                continue;
+            }
+
+            if (i > lineStart && CanBreakBefore(previous, rune))
+            {
+                breakAt = i;
+                widthAfterBreak = 0;
+            }
+
+            if (lineWidth + width > Width && i > lineStart)
+            {
+                if (breakAt > lineStart)
+                {
+                    lineStart = breakAt;
+                    lineWidth = widthAfterBreak;
+                    lines++;
+                    breaks?.Add(lineStart);
+                }
+
+                // No place left to break: the word is wider than the box
+                if (lineWidth + width > Width && i > lineStart)
+                {
+                    if (tooWideAt < 0)
+                    {
+                        tooWideAt = lineStart;
+                    }
+                    lineStart = i;
+                    lineWidth = 0;
+                    lines++;
+                    breaks?.Add(lineStart);
+                }
+
+                breakAt = -1;
+                widthAfterBreak = 0;
+            }
+            else if (width > Width && tooWideAt < 0)
+            {
+                tooWideAt = i;
+            }
+
+            lineWidth += width;
+            widthAfterBreak += width;
+            previous = rune;
+            i += length;
+        }
+
+        return lines;
+    }
+
+    private static bool CanBreakBefore(Rune previous, Rune current)
+    {
+        if (IsClosingPunctuation(current))
+        {
+            return false;
+        }
+
+        return previous.Value == '-' || IsCjk(previous) || IsCjk(current);
+    }
+
+    // Han, kana, Hangul, CJK punctuation and fullwidth forms
+    private static bool IsCjk(Rune rune)
+    {
+        var c = rune.Value;
+        return c is >= 0x2E80 and <= 0x9FFF
+            or >= 0xAC00 and <= 0xD7AF
+            or >= 0xF900 and <= 0xFAFF
+            or >= 0xFF00 and <= 0xFFEF
+            or >= 0x20000 and <= 0x3FFFF;
+    }
+
+    // Characters that must not start a line
+    private static bool IsClosingPunctuation(Rune rune)
+    {
+        return rune.Value is '.' or ',' or '!' or '?' or ':' or ';' or ')' or ']' or '}' or '"' or '\''
+            or '。' or '、' or '，' or '．' or '！' or '？' or '：' or '；' or '）' or '」' or '』' or '】' or '〉' or '》'
+            or 'ー' or '々' or '…' or '・';
+    }
+
+    public static bool TryLoad(string path, out TextLayout? layout, out string? error)
+    {
+        layout = null;
+        if (!File.Exists(path))
+        {
+            error = $"cannot open layout file {path}. Does it exist?";
+            return false;
+        }
+
+        try
+        {
+            using var document = JsonDocument.Parse(File.ReadAllBytes(path),
+                new JsonDocumentOptions { CommentHandling = JsonCommentHandling.Skip, AllowTrailingCommas = true });
+            return TryParse(document.RootElement, out layout, out error, path);
+        }
+        catch (JsonException e)
+        {
+            error = $"{path}: {e.Message}";
+            return false;
+        }
+    }
+
+    public static bool TryParse(JsonElement root, out TextLayout? layout, out string? error, string source = "layout")
+    {
+        layout = null;
+        error = null;
+
+        if (root.ValueKind != JsonValueKind.Object)
+        {
+            error = $"{source}: expected an object with width, lines, default and glyphs";
+            return false;
+        }
+
+        if (!TryGetCount(root, "width", required: true, out var width, ref error, source) ||
+            !TryGetCount(root, "lines", required: true, out var lines, ref error, source) ||
+            !TryGetCount(root, "pages", required: false, out var pages, ref error, source) ||
+            !TryGetCount(root, "default", required: true, out var defaultWidth, ref error, source))
+        {
+            return false;
+        }
+
+        var glyphs = new Dictionary<int, int>();
+        var ranges = new List<(int First, int Last, int Width)>();
+        if (root.TryGetProperty("glyphs", out var glyphTable))
+        {
+            if (glyphTable.ValueKind != JsonValueKind.Object)
+            {
+                error = $"{source}: 'glyphs' must be an object of \"character\": width";
+                return false;
+            }
+
+            foreach (var glyph in glyphTable.EnumerateObject())
+            {
+                var glyphWidth = 0;
+                if (glyph.Value.ValueKind != JsonValueKind.Number || !glyph.Value.TryGetInt32(out glyphWidth) || glyphWidth < 0)
+                {
+                    error = $"{source}: width of '{glyph.Name}' must be a number >= 0";
+                    return false;
+                }
+
+                if (TryParseRange(glyph.Name, out var first, out var last))
+                {
+                    ranges.Add((first, last, glyphWidth));
+                }
+                else if (Rune.DecodeFromUtf16(glyph.Name, out var rune, out var consumed) == OperationStatus.Done &&
+                         consumed == glyph.Name.Length)
+                {
+                    glyphs[rune.Value] = glyphWidth;
+                }
+                else
+                {
+                    error = $"{source}: '{glyph.Name}' is not a single character or a U+XXXX-U+YYYY range";
+                    return false;
+                }
+            }
+        }
+
+        layout = new TextLayout(width, lines, pages == 0 ? 1 : pages, defaultWidth, glyphs, ranges);
+        return true;
+    }
+
+    private static bool TryGetCount(JsonElement root, string name, bool required, out int value, ref string? error, string source)
+    {
+        value = 0;
+        if (!root.TryGetProperty(name, out var element))
+        {
+            if (required)
+            {
+                error = $"{source}: missing '{name}'";
+            }
+            return !required;
+        }
+
+        // TryGetInt32 throws on anything that isn't a number ("480")
+        if (element.ValueKind != JsonValueKind.Number || !element.TryGetInt32(out value) || value <= 0)
+        {
+            error = $"{source}: '{name}' must be a number > 0";
+            return false;
+        }
+
+        return true;
+    }
+
+    // U+4E00-U+9FFF
+    private static bool TryParseRange(string key, out int first, out int last)
+    {
+        first = last = 0;
+        var dash = key.IndexOf('-', 1);
+        return key.StartsWith("U+", StringComparison.OrdinalIgnoreCase) && dash > 0 &&
+               key.AsSpan(dash + 1).StartsWith("U+", StringComparison.OrdinalIgnoreCase) &&
+               int.TryParse(key.AsSpan(2, dash - 2), NumberStyles.AllowHexSpecifier, CultureInfo.InvariantCulture, out first) &&
+               int.TryParse(key.AsSpan(dash + 3), NumberStyles.AllowHexSpecifier, CultureInfo.InvariantCulture, out last) &&
+               first <= last;
+    }
+}
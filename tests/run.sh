@@ -0,0 +1,48 @@
+#!/usr/bin/env bash
+# Compiles every tests/*.ds that has a .expected file and compares the output (colors stripped,
+# exit code last) with it. The first line of a script says how to run it:
+#
+#     // args: --banned banned.txt                 # dialscript <script> --banned banned.txt
+#     // run: $dialscript fmt x.ds && cat x.ds     # any command, for directories, stdin, fmt, ...
+#
+# Scripts run in a scratch copy of tests/, so --fix, fmt and --emit leave the tree alone.
+#
+#     tests/run.sh             # Build first, runs the Release build
+#     tests/run.sh --update    # Rewrites the .expected files
+#
+# DIALSCRIPT overrides the command, e.g. DIALSCRIPT="dotnet path/to/dialscript.dll"
+set -u
+tests=$(cd "$(dirname "$0")" && pwd)
+export dialscript=${DIALSCRIPT:-"dotnet run --project $tests/.. -c Release --no-build --"}
+
+update=false
+[ "${1:-}" = "--update" ] && update=true
+
+scratch=$(mktemp -d)
+trap 'rm -rf "$scratch"' EXIT
+
+failed=0
+for script in "$tests"/*.ds; do
+    name=$(basename "$script")
+    expected="${script%.ds}.expected"
+    [ -f "$expected" ] || $update || continue
+
+    rm -rf "${scratch:?}"/* && cp -R "$tests"/. "$scratch"
+    first=$(head -n 1 "$script")
+    case "$first" in
+        "// run: "*) command=${first#// run: } ;;
+        "// args: "*) command="\$dialscript $name ${first#// args: }" ;;
+        *) command="\$dialscript $name" ;;
+    esac
+
+    actual=$(cd "$scratch" && eval "$command" 2>&1; echo "[exit $?]")
+    actual=$(printf '%s\n' "$actual" | sed -e 's/\x1b\[[0-9;]*m//g' -e 's/\r$//')
+
+    if $update; then
+        printf '%s\n' "$actual" > "$expected"
+    elif ! diff -u "$expected" <(printf '%s\n' "$actual"); then
+        echo "FAILED: $name"
+        failed=1
+    fi
+done
+exit $failed